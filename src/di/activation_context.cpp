@@ -12,14 +12,25 @@ using namespace boost::uuids;
 
 namespace di {
 
+namespace {
+
+uuid generate_uuid()
+{
+    static thread_local random_generator generator;
+    return generator();
+}
+
+}
+
 activation_context::activation_context(
         const string& id,
         const instance_activator& activator)
     :
         id_(id),
-        uuid_(random_generator()()),
+        uuid_(generate_uuid()),
         activator_(activator),
         parent_(boost::none),
+        definition_(nullptr),
         annotations_()
 {
 
@@ -31,9 +42,10 @@ activation_context::activation_context(
         annotations_map&& annotations)
     :
         id_(id),
-        uuid_(random_generator()()),
+        uuid_(generate_uuid()),
         activator_(activator),
         parent_(boost::none),
+        definition_(nullptr),
         annotations_(std::move(annotations))
 {
 
@@ -46,9 +58,10 @@ activation_context::activation_context(
     :
         id_(id),
         description_(description),
-        uuid_(random_generator()()),
+        uuid_(generate_uuid()),
         activator_(parent.activator_),
         parent_(parent),
+        definition_(nullptr),
         annotations_(parent.annotations_)
 {
 
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "annotations_map.hpp"
+#include "unique_ref.hpp"
 
 #include <boost/optional.hpp>
 #include <boost/uuid/uuid.hpp>
 
+#include <future>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -13,14 +15,30 @@
 
 namespace di {
 
+class definition;
 class instance_activator;
 
+template <typename signature_type>
+class factory;
+
+template <typename T>
+class lazy;
+
+template <typename T>
+class constructor_injection;
+
 /**
  * @brief Represents an activation context accessible within activation callback.
  */
 class activation_context
 {
 public:
+    template <typename T>
+    struct id_of
+    {
+        using type = std::string;
+    };
+
     template <typename T, typename... args_types>
     class activation
     {
@@ -155,6 +173,95 @@ public:
     template <typename T, typename... args_types>
     T activate_raii(const std::string& id, args_types... args) const;
 
+    template <typename T, typename... args_types>
+    unique_ref<T> activate_unique_ref(const std::string& id, args_types... args) const;
+
+    /**
+     * @brief Creates a factory of T bound to a definition with given id.
+     * @details
+     * The definition is resolved once, when the factory is created. Obtained factory doesn't reference this context
+     * and can be retained by the activated component to create instances of T later.
+     *
+     * @tparam T Type created by the factory.
+     * @tparam args_types Activation argument types accepted by the factory.
+     * @param id Definition identifier.
+     * @return A factory of T.
+     */
+    template <typename T, typename... args_types>
+    factory<T(args_types...)> activate_factory(const std::string& id) const;
+
+    /**
+     * @brief Creates a lazy dependency of T activated on first access.
+     * @details
+     * The definition is resolved immediately, activation arguments and annotations of this context are captured.
+     * The actual instance is activated when the lazy dependency is dereferenced for the first time.
+     *
+     * @tparam T Type of the dependency.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @param args Activation arguments, captured by value.
+     * @return A lazy dependency of T.
+     */
+    template <typename T, typename... args_types>
+    lazy<T> activate_lazy(const std::string& id, args_types... args) const;
+
+    /**
+     * @brief Activates a unique instance of T asynchronously.
+     * @details
+     * Activation is submitted to the shared thread pool as a child of this context. Independent dependencies can be
+     * activated concurrently this way:
+     * @code
+     * builder.define_default<engine>([](const activation_context& context) -> engine
+     * {
+     *      auto storage = context.activate_default_async<storage>();
+     *      auto network = context.activate_default_async<network>();
+     *
+     *      return engine(context.wait(storage), context.wait(network));
+     * });
+     * @endcode
+     * Returned future has to be waited for before the activation owning this context completes.
+     *
+     * @tparam T Type to activate.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @param args Activation arguments, captured by value.
+     * @return A future of the activated instance.
+     */
+    template <typename T, typename... args_types>
+    std::future<std::unique_ptr<T>> activate_async(const std::string& id, args_types... args) const;
+
+    /**
+     * @brief Activates unique instances of independent dependencies concurrently.
+     * @details
+     * Each dependency is activated asynchronously, as with **activate_async**, the call returns once all of them are
+     * activated. In case of failures, the first failure is rethrown after all activations completed. For instance:
+     * @code
+     * builder.define_default<engine>([](const activation_context& context) -> engine
+     * {
+     *      auto dependencies = context.activate_all<storage, network>("primary", "public");
+     *      return engine(std::move(std::get<0>(dependencies)), std::move(std::get<1>(dependencies)));
+     * });
+     * @endcode
+     *
+     * @tparam T Types to activate.
+     * @param ids Definition identifiers, one for each type.
+     * @return A tuple of activated instances.
+     */
+    template <typename... T>
+    std::tuple<std::unique_ptr<T>...> activate_all(const typename id_of<T>::type&... ids) const;
+
+    /**
+     * @brief Waits for a future, executing pending asynchronous activations on the calling thread in the meantime.
+     * @tparam R Future result type.
+     * @param future A future to wait for.
+     * @return Result of the future.
+     */
+    template <typename R>
+    R wait(std::future<R>& future) const;
+
+    template <typename R>
+    R wait(std::future<R>&& future) const;
+
     template <typename T, typename... args_types>
     activation<T, args_types...> activate_default(args_types... args) const;
 
@@ -170,15 +277,46 @@ public:
     template <typename T, typename... args_types>
     T activate_default_raii(args_types... args) const;
 
+    template <typename T, typename... args_types>
+    unique_ref<T> activate_default_unique_ref(args_types... args) const;
+
+    template <typename T, typename... args_types>
+    factory<T(args_types...)> activate_default_factory() const;
+
+    template <typename T, typename... args_types>
+    lazy<T> activate_default_lazy(args_types... args) const;
+
+    template <typename T, typename... args_types>
+    std::future<std::unique_ptr<T>> activate_default_async(args_types... args) const;
+
+    template <typename... T>
+    std::tuple<std::unique_ptr<T>...> activate_default_all() const;
+
 private:
     friend instance_activator;
+    friend class definition_builder;
+
+    template <typename T>
+    friend class constructor_injection;
     friend std::ostream& operator<<(std::ostream& os, const activation_context& context);
 
+    /**
+     * @brief Activates T with given binding within this context and wraps it into a new instance of D.
+     */
+    template <typename D, typename T, typename binding_type, typename... args_types>
+    D* activate_wrapped(const binding_type& binding, args_types... args) const;
+
+    template <typename... T, size_t... indexes>
+    std::tuple<std::unique_ptr<T>...> wait_all(
+            std::tuple<std::future<std::unique_ptr<T>>...>& pending,
+            std::index_sequence<indexes...>) const;
+
     std::string id_;
     std::string description_;
     boost::uuids::uuid uuid_;
     const instance_activator& activator_;
     boost::optional<const activation_context&> parent_;
+    const definition* definition_;
 
     annotations_map annotations_;
 
@@ -2,8 +2,13 @@
 
 #include "instance_activator.hpp"
 #include "activation_context.hpp"
+#include "factory.hpp"
+#include "lazy.hpp"
 
 #include <di/tools/cxxabi_utils.hpp>
+#include <di/tools/thread_pool.hpp>
+
+#include <exception>
 
 
 namespace di {
@@ -210,9 +215,7 @@ inline std::shared_ptr<T> activation_context::activation<T, args_types...>::forw
         std::index_sequence<args_count...>) const
 {
     auto& activator = context_->activator_;
-    auto& id = context_->id_;
-
-    return activator.template activate_shared<T, args_types...>(id, std::get<args_count>(args_)...);
+    return activator.template activate_shared<T, args_types...>(*context_, std::get<args_count>(args_)...);
 }
 
 template <typename A>
@@ -254,6 +257,15 @@ inline std::unique_ptr<T> activation_context::activate_unique(
     return activator_.activate_unique<T, args_types...>(context, args...);
 }
 
+template <typename T, typename... args_types>
+inline unique_ref<T> activation_context::activate_unique_ref(
+        const std::string& id,
+        args_types... args) const
+{
+    activation_context context(id, "", *this);
+    return activator_.activate_unique_ref<T, args_types...>(context, args...);
+}
+
 template <typename T, typename... args_types>
 inline std::shared_ptr<T> activation_context::activate_shared(
         const std::string& id,
@@ -272,6 +284,64 @@ inline T activation_context::activate_raii(
     return activator_.activate_raii<T, args_types...>(context, args...);
 }
 
+template <typename D, typename T, typename binding_type, typename... args_types>
+inline D* activation_context::activate_wrapped(const binding_type& binding, args_types... args) const
+{
+    return activator_.template activate_wrapped<D, T, args_types...>(binding, *this, args...);
+}
+
+template <typename T, typename... args_types>
+inline factory<T(args_types...)> activation_context::activate_factory(
+        const std::string& id) const
+{
+    return factory<T(args_types...)>(activator_.resolve<T, args_types...>(id));
+}
+
+template <typename T, typename... args_types>
+inline lazy<T> activation_context::activate_lazy(
+        const std::string& id,
+        args_types... args) const
+{
+    return lazy<T>(activator_.resolve<T, args_types...>(id), annotations_, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::future<std::unique_ptr<T>> activation_context::activate_async(
+        const std::string& id,
+        args_types... args) const
+{
+    auto& binding = activator_.find<T, args_types...>(id).second.template bound<T, args_types...>();
+    return tools::thread_pool::shared().submit([this, &binding, id, args...]()
+    {
+        activation_context context(id, "", *this);
+        return activator_.activate_unique<T, args_types...>(binding, context, args...);
+    });
+}
+
+template <typename... T>
+inline std::tuple<std::unique_ptr<T>...> activation_context::activate_all(
+        const typename id_of<T>::type&... ids) const
+{
+    // resolve all definitions before submission, no activation may outlive this call
+    int resolved[] = { 0, (activator_.find<T>(ids), 0)... };
+    (void) resolved;
+
+    std::tuple<std::future<std::unique_ptr<T>>...> pending(activate_async<T>(ids)...);
+    return wait_all<T...>(pending, std::index_sequence_for<T...>{});
+}
+
+template <typename R>
+inline R activation_context::wait(std::future<R>& future) const
+{
+    return tools::thread_pool::shared().wait(future);
+}
+
+template <typename R>
+inline R activation_context::wait(std::future<R>&& future) const
+{
+    return tools::thread_pool::shared().wait(future);
+}
+
 template <typename T, typename... args_types>
 inline activation_context::activation<T, args_types...> activation_context::activate_default(
         args_types... args) const
@@ -294,6 +364,13 @@ inline std::unique_ptr<T> activation_context::activate_default_unique(
     return activate_unique<T, args_types...>(definition::default_id, args...);
 }
 
+template <typename T, typename... args_types>
+inline unique_ref<T> activation_context::activate_default_unique_ref(
+        args_types... args) const
+{
+    return activate_unique_ref<T, args_types...>(definition::default_id, args...);
+}
+
 template <typename T, typename... args_types>
 inline std::shared_ptr<T> activation_context::activate_default_shared(
         args_types... args) const
@@ -308,5 +385,62 @@ inline T activation_context::activate_default_raii(
     return activate_raii<T, args_types...>(definition::default_id, args...);
 }
 
+template <typename T, typename... args_types>
+inline factory<T(args_types...)> activation_context::activate_default_factory() const
+{
+    return activate_factory<T, args_types...>(definition::default_id);
+}
+
+template <typename T, typename... args_types>
+inline lazy<T> activation_context::activate_default_lazy(
+        args_types... args) const
+{
+    return activate_lazy<T, args_types...>(definition::default_id, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::future<std::unique_ptr<T>> activation_context::activate_default_async(
+        args_types... args) const
+{
+    return activate_async<T, args_types...>(definition::default_id, args...);
 }
 
+template <typename... T>
+inline std::tuple<std::unique_ptr<T>...> activation_context::activate_default_all() const
+{
+    return activate_all<T...>(typename id_of<T>::type(definition::default_id)...);
+}
+
+template <typename... T, size_t... indexes>
+inline std::tuple<std::unique_ptr<T>...> activation_context::wait_all(
+        std::tuple<std::future<std::unique_ptr<T>>...>& pending,
+        std::index_sequence<indexes...>) const
+{
+    std::tuple<std::unique_ptr<T>...> activated;
+    std::exception_ptr failure;
+
+    auto wait_one = [this, &failure](auto& future, auto& instance)
+    {
+        try
+        {
+            instance = wait(future);
+        }
+        catch (...)
+        {
+            if (!failure)
+                failure = std::current_exception();
+        }
+
+        return 0;
+    };
+
+    int expansion[] = { 0, wait_one(std::get<indexes>(pending), std::get<indexes>(activated))... };
+    (void) expansion;
+
+    if (failure)
+        std::rethrow_exception(failure);
+
+    return activated;
+}
+
+}
@@ -0,0 +1,172 @@
+#include "activation_statistics.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+
+using namespace std;
+
+
+namespace di {
+
+constexpr size_t activation_statistics::cache_line_size;
+constexpr size_t activation_statistics::shards_count;
+constexpr size_t activation_statistics::recorded_dependencies_count;
+
+activation_statistics::activation_statistics()
+    : shards_(shards_count)
+{
+    for (auto i = 0u; i < shards_count; i++)
+    {
+        auto& shard = shards_[i];
+        shard.activations.store(0u, memory_order_relaxed);
+        shard.failures.store(0u, memory_order_relaxed);
+        shard.creation_time.store(0u, memory_order_relaxed);
+        shard.max_creation_time.store(0u, memory_order_relaxed);
+        shard.live_instances.store(0u, memory_order_relaxed);
+        shard.live_bytes.store(0u, memory_order_relaxed);
+    }
+
+    for (auto& recorded : recorded_dependencies_)
+        recorded.store(nullptr, memory_order_relaxed);
+}
+
+void activation_statistics::record(duration_type creation_time)
+{
+    auto& shard = local_shard();
+    auto elapsed = static_cast<uint64_t>(creation_time.count());
+
+    shard.activations.fetch_add(1u, memory_order_relaxed);
+    shard.creation_time.fetch_add(elapsed, memory_order_relaxed);
+
+    auto max = shard.max_creation_time.load(memory_order_relaxed);
+    while (elapsed > max && !shard.max_creation_time.compare_exchange_weak(max, elapsed, memory_order_relaxed))
+        ;
+}
+
+void activation_statistics::record_failure()
+{
+    local_shard().failures.fetch_add(1u, memory_order_relaxed);
+}
+
+void activation_statistics::record_acquire(size_t size)
+{
+    auto& shard = local_shard();
+    shard.live_instances.fetch_add(1u, memory_order_relaxed);
+    shard.live_bytes.fetch_add(size, memory_order_relaxed);
+}
+
+void activation_statistics::record_release(size_t size)
+{
+    auto& shard = local_shard();
+    shard.live_instances.fetch_sub(1u, memory_order_relaxed);
+    shard.live_bytes.fetch_sub(size, memory_order_relaxed);
+}
+
+void activation_statistics::record_dependency(const definition* dependency)
+{
+    auto start = hash<const definition*>()(dependency) / alignof(max_align_t);
+    for (auto i = 0u; i < recorded_dependencies_count; i++)
+    {
+        auto& recorded = recorded_dependencies_[(start + i) % recorded_dependencies_count];
+
+        auto current = recorded.load(memory_order_acquire);
+        if (!current && recorded.compare_exchange_strong(current, dependency, memory_order_acq_rel))
+            return;
+
+        if (current == dependency)
+            return;
+    }
+
+    lock_guard<mutex> lock(dependencies_mutex_);
+    dependencies_.insert(dependency);
+}
+
+uint64_t activation_statistics::activations() const
+{
+    return aggregate(&counters::activations, plus<uint64_t>());
+}
+
+uint64_t activation_statistics::failures() const
+{
+    return aggregate(&counters::failures, plus<uint64_t>());
+}
+
+activation_statistics::duration_type activation_statistics::creation_time() const
+{
+    return duration_type(aggregate(&counters::creation_time, plus<uint64_t>()));
+}
+
+activation_statistics::duration_type activation_statistics::mean_creation_time() const
+{
+    auto count = activations();
+    if (count == 0u)
+        return duration_type::zero();
+
+    return duration_type(creation_time().count() / count);
+}
+
+activation_statistics::duration_type activation_statistics::max_creation_time() const
+{
+    return duration_type(aggregate(&counters::max_creation_time, [](uint64_t first, uint64_t second)
+    {
+        return max(first, second);
+    }));
+}
+
+uint64_t activation_statistics::live_instances() const
+{
+    return aggregate(&counters::live_instances, plus<uint64_t>());
+}
+
+uint64_t activation_statistics::live_bytes() const
+{
+    return aggregate(&counters::live_bytes, plus<uint64_t>());
+}
+
+activation_statistics::snapshot_type activation_statistics::snapshot() const
+{
+    return { activations(), failures(), creation_time(), max_creation_time(), live_instances(), live_bytes() };
+}
+
+vector<const definition*> activation_statistics::dependencies() const
+{
+    vector<const definition*> dependencies;
+    for (auto& recorded : recorded_dependencies_)
+    {
+        auto dependency = recorded.load(memory_order_acquire);
+        if (dependency)
+            dependencies.push_back(dependency);
+    }
+
+    lock_guard<mutex> lock(dependencies_mutex_);
+    dependencies.insert(dependencies.end(), dependencies_.begin(), dependencies_.end());
+
+    return dependencies;
+}
+
+size_t activation_statistics::shard_index()
+{
+    static thread_local auto index = hash<thread::id>()(this_thread::get_id()) % shards_count;
+    return index;
+}
+
+activation_statistics::shard& activation_statistics::local_shard()
+{
+    return shards_[shard_index()];
+}
+
+template <typename accumulator_type>
+uint64_t activation_statistics::aggregate(
+        atomic<uint64_t> counters::* counter,
+        accumulator_type accumulator) const
+{
+    uint64_t result = 0u;
+    for (auto i = 0u; i < shards_count; i++)
+        result = accumulator(result, (shards_[i].*counter).load(memory_order_relaxed));
+
+    return result;
+}
+
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <di/tools/aligned_array.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_set>
+#include <vector>
+
+
+namespace di {
+
+class definition;
+
+/**
+ * @brief Statistics of activations of a single definition.
+ * @details
+ * Statistics are collected by **instance_activator** only when enabled with
+ * **instance_activator::set_statistics_enabled**. Creation time is inclusive - it covers activation of all
+ * dependencies activated from within the factory.
+ *
+ * Counters are kept in shards padded and aligned to the size of a cache line. Each thread updates the shard selected by
+ * its id, reads aggregate all shards. Live counters are sums of increments and decrements modulo 2^64, an instance
+ * released on a different thread than acquired leaves both shards wrapped but their sum exact.
+ */
+class activation_statistics
+{
+public:
+    using duration_type = std::chrono::nanoseconds;
+
+    /**
+     * @brief Aggregated counters at the moment of a snapshot.
+     */
+    struct snapshot_type
+    {
+        uint64_t activations;
+        uint64_t failures;
+        duration_type creation_time;
+        duration_type max_creation_time;
+        /**
+         * @brief Shared and unique_ref instances not destroyed yet. Unique and RAII instances are owned without tracking.
+         */
+        uint64_t live_instances;
+        /**
+         * @brief Size of live instances, as sizes of their activated types.
+         */
+        uint64_t live_bytes;
+    };
+
+    activation_statistics();
+
+    /**
+     * @brief Non-copy constructable.
+     */
+    activation_statistics(const activation_statistics& other) = delete;
+    /**
+     * @brief Non-copy assignable.
+     */
+    activation_statistics& operator=(const activation_statistics& other) = delete;
+
+    /**
+     * @brief Records a completed activation.
+     * @param creation_time Time spent creating the instance.
+     */
+    void record(duration_type creation_time);
+
+    /**
+     * @brief Records an activation which ended with an exception.
+     */
+    void record_failure();
+
+    /**
+     * @brief Records an activated instance tracked until **record_release**.
+     * @param size Size of the instance.
+     */
+    void record_acquire(size_t size);
+
+    /**
+     * @brief Records destruction of an instance tracked with **record_acquire**.
+     * @param size Size of the instance.
+     */
+    void record_release(size_t size);
+
+    /**
+     * @brief Records a definition activated from within an activation of the owning definition.
+     * @details
+     * Dependencies already recorded are recognized without taking a lock, the lock is taken only after more distinct
+     * dependencies are recorded than fit in the lock-free table.
+     *
+     * @param dependency Activated definition.
+     */
+    void record_dependency(const definition* dependency);
+
+    uint64_t activations() const;
+
+    uint64_t failures() const;
+
+    duration_type creation_time() const;
+
+    duration_type mean_creation_time() const;
+
+    duration_type max_creation_time() const;
+
+    uint64_t live_instances() const;
+
+    uint64_t live_bytes() const;
+
+    snapshot_type snapshot() const;
+
+    std::vector<const definition*> dependencies() const;
+
+private:
+    static constexpr size_t cache_line_size = 64u;
+    static constexpr size_t shards_count = 16u;
+    static constexpr size_t recorded_dependencies_count = 16u;
+
+    struct counters
+    {
+        std::atomic<uint64_t> activations;
+        std::atomic<uint64_t> failures;
+        std::atomic<uint64_t> creation_time;
+        std::atomic<uint64_t> max_creation_time;
+        std::atomic<uint64_t> live_instances;
+        std::atomic<uint64_t> live_bytes;
+    };
+
+    struct shard : counters
+    {
+        char padding[cache_line_size - sizeof(counters) % cache_line_size];
+    };
+
+    static size_t shard_index();
+
+    shard& local_shard();
+
+    template <typename accumulator_type>
+    uint64_t aggregate(std::atomic<uint64_t> counters::* counter, accumulator_type accumulator) const;
+
+    tools::aligned_array<shard, cache_line_size> shards_;
+
+    std::array<std::atomic<const definition*>, recorded_dependencies_count> recorded_dependencies_;
+
+    mutable std::mutex dependencies_mutex_;
+    std::unordered_set<const definition*> dependencies_;
+
+};
+
+/**
+ * @brief Statistics snapshot of a single definition, see **instance_activator::metrics**.
+ */
+struct activation_metrics
+{
+    std::string id;
+    std::type_index type;
+    activation_statistics::snapshot_type statistics;
+};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+
+
+namespace di {
+
+class activation_context;
+
+/**
+ * @brief Describes a single activation reported to **activation_tracer**.
+ */
+struct activation_event
+{
+    /**
+     * @brief Id of the activated definition.
+     */
+    const std::string& id;
+    /**
+     * @brief Activated type.
+     */
+    const std::type_info& type;
+    /**
+     * @brief Number of activations this activation is nested in, 0 for activations started by the activator.
+     */
+    size_t depth;
+    /**
+     * @brief Context of the activation, its parent context identifies the dependent activation.
+     */
+    const activation_context& context;
+    /**
+     * @brief Time elapsed since the activation began, inclusive of nested activations. Zero when the activation begins.
+     */
+    std::chrono::nanoseconds elapsed;
+    /**
+     * @brief Set when the activation ends with an exception.
+     */
+    bool failed;
+};
+
+/**
+ * @brief Receives begin and end events of activations.
+ * @details
+ * Installed with **instance_activator::set_tracer**. Both callbacks are invoked on the activating thread, possibly
+ * concurrently for asynchronous activations. Events of nested activations are reported between begin and end events of
+ * their dependent activation. For instance:
+ * @code
+ * class latency_tracer : public di::activation_tracer
+ * {
+ * public:
+ *      void begin(const di::activation_event& event) override
+ *      {
+ *      }
+ *
+ *      void end(const di::activation_event& event) override
+ *      {
+ *          histogram_.record(event.id, event.elapsed);
+ *      }
+ * };
+ *
+ * activator.set_tracer(std::make_shared<latency_tracer>());
+ * @endcode
+ */
+class activation_tracer
+{
+public:
+    virtual ~activation_tracer() = default;
+
+    /**
+     * @brief Invoked before the instance is created.
+     */
+    virtual void begin(const activation_event& event) = 0;
+
+    /**
+     * @brief Invoked after the instance is created, intercepted and decorated or once its creation failed.
+     */
+    virtual void end(const activation_event& event) = 0;
+
+};
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "annotations_map.hpp"
+#include "definition.hpp"
+#include "unique_ref.hpp"
+
+#include <memory>
+#include <string>
+
+
+namespace di {
+
+class activation_context;
+class instance_activator;
+
+/**
+ * @brief A handle to a definition resolved by **instance_activator**.
+ * @details
+ * A handle is obtained with **instance_activator::resolve** and binds directly to the resolved definition, its
+ * interceptors and decorators. Activation through a handle skips definition id construction, hashing and lookup,
+ * which makes it suitable for hot paths activating the same type repeatedly. For instance:
+ * @code
+ * instance_activator activator(std::move(builder));
+ * auto handle = activator.resolve_default<TestObject_1, string>();
+ *
+ * auto first = handle.activate_unique("first");
+ * auto second = handle.activate_unique("second");
+ * @endcode
+ *
+ * Handles are cheap to copy. A handle is valid for as long as the activator which created it is alive and isn't moved.
+ *
+ * @tparam T Activated type.
+ * @tparam args_types Activation argument types.
+ */
+template <typename T, typename... args_types>
+class activator_handle
+{
+public:
+    /**
+     * @brief Default copy constructable.
+     */
+    activator_handle(const activator_handle& other) = default;
+    /**
+     * @brief Default move constructable.
+     */
+    activator_handle(activator_handle&& other) = default;
+    /**
+     * @brief Default copy assignable.
+     */
+    activator_handle& operator=(const activator_handle& other) = default;
+    /**
+     * @brief Default move assignable.
+     */
+    activator_handle& operator=(activator_handle&& other) = default;
+
+    const std::string& id() const;
+
+    std::unique_ptr<T> activate_unique(args_types... args) const;
+
+    std::shared_ptr<T> activate_shared(args_types... args) const;
+
+    T activate_raii(args_types... args) const;
+
+    unique_ref<T> activate_unique_ref(args_types... args) const;
+
+    std::unique_ptr<T> activate_unique(annotations_map&& annotations, args_types... args) const;
+
+    std::shared_ptr<T> activate_shared(annotations_map&& annotations, args_types... args) const;
+
+    T activate_raii(annotations_map&& annotations, args_types... args) const;
+
+    std::unique_ptr<T> activate_unique(activation_context& context, args_types... args) const;
+
+    std::shared_ptr<T> activate_shared(activation_context& context, args_types... args) const;
+
+    T activate_raii(activation_context& context, args_types... args) const;
+
+    unique_ref<T> activate_unique_ref(activation_context& context, args_types... args) const;
+
+private:
+    friend instance_activator;
+
+    explicit activator_handle(
+            const instance_activator& activator,
+            const std::string& id,
+            const definition::binding<T, args_types...>& binding);
+
+    const instance_activator* activator_;
+    const std::string* id_;
+    const definition::binding<T, args_types...>* binding_;
+
+};
+
+}
+
+#include "activator_handle.ipp"
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "activator_handle.hpp"
+#include "activation_context.hpp"
+#include "instance_activator.hpp"
+
+
+namespace di {
+
+template <typename T, typename... args_types>
+inline activator_handle<T, args_types...>::activator_handle(
+        const instance_activator& activator,
+        const std::string& id,
+        const definition::binding<T, args_types...>& binding)
+    :
+        activator_(&activator),
+        id_(&id),
+        binding_(&binding)
+{
+
+}
+
+template <typename T, typename... args_types>
+inline const std::string& activator_handle<T, args_types...>::id() const
+{
+    return *id_;
+}
+
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> activator_handle<T, args_types...>::activate_unique(
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_);
+    return activate_unique(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> activator_handle<T, args_types...>::activate_shared(
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_);
+    return activate_shared(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline T activator_handle<T, args_types...>::activate_raii(
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_);
+    return activate_raii(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline unique_ref<T> activator_handle<T, args_types...>::activate_unique_ref(
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_);
+    return activate_unique_ref(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> activator_handle<T, args_types...>::activate_unique(
+        annotations_map&& annotations,
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_, std::move(annotations));
+    return activate_unique(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> activator_handle<T, args_types...>::activate_shared(
+        annotations_map&& annotations,
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_, std::move(annotations));
+    return activate_shared(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline T activator_handle<T, args_types...>::activate_raii(
+        annotations_map&& annotations,
+        args_types... args) const
+{
+    activation_context context(*id_, *activator_, std::move(annotations));
+    return activate_raii(context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> activator_handle<T, args_types...>::activate_unique(
+        activation_context& context,
+        args_types... args) const
+{
+    return activator_->template activate_unique<T, args_types...>(*binding_, context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> activator_handle<T, args_types...>::activate_shared(
+        activation_context& context,
+        args_types... args) const
+{
+    return activator_->template activate_shared<T, args_types...>(*binding_, context, args...);
+}
+
+template <typename T, typename... args_types>
+inline T activator_handle<T, args_types...>::activate_raii(
+        activation_context& context,
+        args_types... args) const
+{
+    return activator_->template activate_raii<T, args_types...>(*binding_, context, args...);
+}
+
+template <typename T, typename... args_types>
+inline unique_ref<T> activator_handle<T, args_types...>::activate_unique_ref(
+        activation_context& context,
+        args_types... args) const
+{
+    return activator_->template activate_unique_ref<T, args_types...>(*binding_, context, args...);
+}
+
+}
@@ -3,6 +3,7 @@
 #include <boost/any.hpp>
 
 #include <iostream>
+#include <type_traits>
 #include <unordered_map>
 #include <typeindex>
 #include <typeinfo>
@@ -12,8 +13,18 @@ namespace di {
 
 class annotations_map
 {
-public:
     template <typename... annotation_types>
+    struct is_copy : std::false_type
+    { };
+
+    template <typename annotation_type>
+    struct is_copy<annotation_type> : std::is_same<typename std::decay<annotation_type>::type, annotations_map>
+    { };
+
+public:
+    template <
+            typename... annotation_types,
+            typename = typename std::enable_if<!is_copy<annotation_types...>::value>::type>
     annotations_map(annotation_types&&... annotations);
 
     template <typename A>
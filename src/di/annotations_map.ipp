@@ -9,7 +9,7 @@
 
 namespace di {
 
-template <typename... annotation_types>
+template <typename... annotation_types, typename>
 inline annotations_map::annotations_map(annotation_types&&... annotations)
     : annotations_()
 {
@@ -0,0 +1,153 @@
+#include "async_dispatcher.hpp"
+
+#include <algorithm>
+
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace di {
+
+namespace {
+
+size_t round_capacity(size_t capacity)
+{
+    size_t rounded = 1u;
+    while (rounded < capacity)
+        rounded <<= 1u;
+
+    return rounded;
+}
+
+}
+
+async_dispatcher::async_dispatcher(size_t capacity)
+    :
+        mask_(round_capacity(max<size_t>(capacity, 2u)) - 1u),
+        slots_(new slot[mask_ + 1u]),
+        tail_(0u),
+        head_(0u),
+        dropped_(0u),
+        stopping_(false)
+{
+    for (size_t i = 0u; i <= mask_; i++)
+        slots_[i].sequence.store(i, memory_order_relaxed);
+
+    thread_ = thread(&async_dispatcher::run, this);
+}
+
+async_dispatcher::~async_dispatcher()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_.store(true, memory_order_release);
+    }
+
+    wake_.notify_one();
+    thread_.join();
+}
+
+bool async_dispatcher::post(const handler_type& handler, const string& id, const type_info& type)
+{
+    auto position = tail_.load(memory_order_relaxed);
+    slot* reserved;
+    for (;;)
+    {
+        reserved = &slots_[position & mask_];
+        auto sequence = reserved->sequence.load(memory_order_acquire);
+        auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0)
+        {
+            if (tail_.compare_exchange_weak(position, position + 1u, memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            dropped_.fetch_add(1u, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = tail_.load(memory_order_relaxed);
+        }
+    }
+
+    reserved->handler = &handler;
+    reserved->id = &id;
+    reserved->type = &type;
+    reserved->activated = steady_clock::now();
+    reserved->sequence.store(position + 1u, memory_order_release);
+
+    return true;
+}
+
+void async_dispatcher::flush()
+{
+    auto target = tail_.load(memory_order_acquire);
+
+    unique_lock<mutex> lock(mutex_);
+    wake_.notify_one();
+    drained_.wait(lock, [this, target]()
+    {
+        return head_.load(memory_order_acquire) >= target;
+    });
+}
+
+uint64_t async_dispatcher::dropped() const
+{
+    return dropped_.load(memory_order_relaxed);
+}
+
+bool async_dispatcher::drain()
+{
+    auto head = head_.load(memory_order_relaxed);
+    auto delivered = false;
+    for (;;)
+    {
+        auto& taken = slots_[head & mask_];
+        if (taken.sequence.load(memory_order_acquire) != head + 1u)
+            break;
+
+        // the slot is released before the handler runs, so a slow handler doesn't hold on to queue capacity
+        auto handler = taken.handler;
+        interception_event event { *taken.id, *taken.type, taken.activated };
+        taken.sequence.store(head + mask_ + 1u, memory_order_release);
+
+        try
+        {
+            (*handler)(event);
+        }
+        catch (...)
+        {
+            // interceptors can't fail activations they observe
+        }
+
+        head_.store(++head, memory_order_release);
+        delivered = true;
+    }
+
+    return delivered;
+}
+
+void async_dispatcher::run()
+{
+    for (;;)
+    {
+        auto delivered = drain();
+
+        unique_lock<mutex> lock(mutex_);
+        drained_.notify_all();
+        if (delivered)
+            continue;
+
+        if (stopping_.load(memory_order_acquire))
+            break;
+
+        wake_.wait_for(lock, milliseconds(10));
+    }
+
+    drain();
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeinfo>
+
+
+namespace di {
+
+/**
+ * @brief Describes an activation delivered to an asynchronous interceptor.
+ */
+struct interception_event
+{
+    /**
+     * @brief Id of the activated definition.
+     */
+    const std::string& id;
+    /**
+     * @brief Activated type.
+     */
+    const std::type_info& type;
+    /**
+     * @brief Moment at which the instance was activated.
+     */
+    std::chrono::steady_clock::time_point activated;
+};
+
+/**
+ * @brief Delivers activations to asynchronous interceptors on a background thread.
+ * @details
+ * Activating threads post events into a bounded multi-producer single-consumer queue without taking any locks or
+ * allocating. The background thread drains the queue and invokes interceptors in the order events were posted. When
+ * the queue is full an event is dropped and counted in **dropped**. Exceptions thrown by interceptors are ignored.
+ *
+ * Events remaining in the queue are delivered before the dispatcher is destroyed.
+ */
+class async_dispatcher
+{
+public:
+    using handler_type = std::function<void(const interception_event&)>;
+
+    /**
+     * @brief Creates a dispatcher and starts its background thread.
+     * @param capacity Number of events the queue can hold, rounded up to a power of 2.
+     */
+    explicit async_dispatcher(size_t capacity = 4096u);
+
+    /**
+     * @brief Non-copy constructable.
+     */
+    async_dispatcher(const async_dispatcher& other) = delete;
+    /**
+     * @brief Non-copy assignable.
+     */
+    async_dispatcher& operator=(const async_dispatcher& other) = delete;
+
+    ~async_dispatcher();
+
+    /**
+     * @brief Posts an event for given handler.
+     * @details
+     * Handler and id have to remain valid until the event is delivered.
+     *
+     * @return **false** if the queue is full and the event has been dropped.
+     */
+    bool post(const handler_type& handler, const std::string& id, const std::type_info& type);
+
+    /**
+     * @brief Waits until all events posted before this call are delivered.
+     */
+    void flush();
+
+    /**
+     * @brief Number of events dropped due to the queue being full.
+     */
+    uint64_t dropped() const;
+
+private:
+    struct slot
+    {
+        std::atomic<size_t> sequence;
+        const handler_type* handler;
+        const std::string* id;
+        const std::type_info* type;
+        std::chrono::steady_clock::time_point activated;
+    };
+
+    bool drain();
+
+    void run();
+
+    const size_t mask_;
+    std::unique_ptr<slot[]> slots_;
+
+    std::atomic<size_t> tail_;
+    std::atomic<size_t> head_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<bool> stopping_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+
+    std::thread thread_;
+
+};
+
+}
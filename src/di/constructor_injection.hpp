@@ -0,0 +1,208 @@
+#pragma once
+
+#include "definition.hpp"
+
+#include <di/tools/traits/constructor_traits.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace di {
+
+class activation_context;
+
+template <typename signature_type>
+class factory;
+
+template <typename T>
+class lazy;
+
+/**
+ * @brief Declares constructor parameters of a component defined with **definition_builder::define_type**.
+ * @details
+ * Declaration is optional, it is required when parameters of a constructor can't be detected, for instance when a
+ * type has multiple constructors with the same number of parameters:
+ * @code
+ * class engine
+ * {
+ * public:
+ *      using inject = di::inject<configuration, std::unique_ptr<storage>>;
+ *
+ *      engine(configuration configuration, std::unique_ptr<storage> storage);
+ *      engine(configuration configuration, std::shared_ptr<storage> storage);
+ * };
+ * @endcode
+ *
+ * @tparam parameter_types Constructor parameter types.
+ */
+template <typename... parameter_types>
+struct inject
+{
+};
+
+/**
+ * @brief A creator of T activating constructor parameters of T from their default definitions.
+ * @details
+ * Each parameter is activated according to its type:
+ * - **std::unique_ptr<D>** - as a unique instance of D,
+ * - **std::shared_ptr<D>** - as a shared instance of D,
+ * - **factory<D(args...)>** - as a factory of D,
+ * - **lazy<D>** - as a lazy dependency of D,
+ * - any other class type D or a const reference to it - as an RAII instance of D.
+ *
+ * Parameters are declared with **T::inject** or detected from the constructor with the greatest number of class type
+ * parameters, aggregates are initialised member by member. A definition of each parameter is resolved on the first
+ * activation and reused afterwards.
+ *
+ * @tparam T Constructed type.
+ */
+template <typename T>
+class constructor_injection
+{
+public:
+    /**
+     * @brief A constructor argument of T, convertible to any class type dependency.
+     * @tparam index Position of the argument.
+     */
+    template <size_t index>
+    class argument
+    {
+    public:
+        explicit argument(const constructor_injection& injection, const activation_context& context);
+
+        template <
+                typename U,
+                typename = std::enable_if_t<
+                        std::is_class<std::decay_t<U>>::value && !std::is_same<std::decay_t<U>, T>::value>>
+        operator U() const;
+
+    private:
+        const constructor_injection& injection_;
+        const activation_context& context_;
+
+    };
+
+    constructor_injection();
+
+    T* operator()(const activation_context& context) const;
+
+    /**
+     * @brief Dependencies of T declared with **T::inject**, no dependencies when constructor parameters are detected.
+     */
+    static std::vector<definition::dependency> dependencies();
+
+private:
+    template <typename U>
+    struct tag
+    {
+    };
+
+    template <typename inject_type>
+    struct declared;
+
+    template <typename... parameter_types>
+    struct declared<di::inject<parameter_types...>>
+    {
+        static constexpr size_t arity = sizeof...(parameter_types);
+
+        template <size_t index>
+        using parameter = std::decay_t<std::tuple_element_t<index, std::tuple<parameter_types...>>>;
+    };
+
+    template <typename U, typename = void>
+    struct has_inject : std::false_type
+    {
+    };
+
+    template <typename U>
+    struct has_inject<U, decltype(void(std::declval<typename U::inject>()))> : std::true_type
+    {
+    };
+
+    using traits = tools::constructor_traits<T, argument<0u>>;
+
+    template <typename U, bool = has_inject<U>::value>
+    struct parameters : std::integral_constant<size_t, traits::arity>
+    {
+    };
+
+    template <typename U>
+    struct parameters<U, true> : std::integral_constant<size_t, declared<typename U::inject>::arity>
+    {
+    };
+
+    static constexpr size_t arity = parameters<T>::value;
+
+    struct state
+    {
+        std::array<std::atomic<const void*>, arity> bindings;
+    };
+
+    template <size_t... indexes>
+    T* create(const activation_context& context, std::index_sequence<indexes...>, std::true_type is_declared) const;
+
+    template <size_t... indexes>
+    T* create(const activation_context& context, std::index_sequence<indexes...>, std::false_type is_declared) const;
+
+    template <size_t... indexes>
+    T* create_detected(const activation_context& context, std::index_sequence<indexes...>, std::true_type braced) const;
+
+    template <size_t... indexes>
+    T* create_detected(const activation_context& context, std::index_sequence<indexes...>, std::false_type braced) const;
+
+    template <size_t... indexes>
+    static std::vector<definition::dependency> dependencies(std::index_sequence<indexes...>, std::true_type is_declared);
+
+    template <size_t... indexes>
+    static std::vector<definition::dependency> dependencies(std::index_sequence<indexes...>, std::false_type is_declared);
+
+    template <typename D>
+    static definition::dependency dependency(tag<std::unique_ptr<D>>);
+
+    template <typename D>
+    static definition::dependency dependency(tag<std::shared_ptr<D>>);
+
+    template <typename D, typename... args_types>
+    static definition::dependency dependency(tag<factory<D(args_types...)>>);
+
+    template <typename D>
+    static definition::dependency dependency(tag<lazy<D>>);
+
+    template <typename D>
+    static definition::dependency dependency(tag<D>);
+
+    template <typename U, size_t index>
+    U activate(const activation_context& context) const;
+
+    template <size_t index, typename D>
+    std::unique_ptr<D> resolve(const activation_context& context, tag<std::unique_ptr<D>>) const;
+
+    template <size_t index, typename D>
+    std::shared_ptr<D> resolve(const activation_context& context, tag<std::shared_ptr<D>>) const;
+
+    template <size_t index, typename D, typename... args_types>
+    factory<D(args_types...)> resolve(const activation_context& context, tag<factory<D(args_types...)>>) const;
+
+    template <size_t index, typename D>
+    lazy<D> resolve(const activation_context& context, tag<lazy<D>>) const;
+
+    template <size_t index, typename D>
+    D resolve(const activation_context& context, tag<D>) const;
+
+    template <typename D, size_t index, typename... args_types>
+    const definition::binding<D, args_types...>& bound(const activation_context& context) const;
+
+    std::shared_ptr<state> state_;
+
+};
+
+}
+
+#include "constructor_injection.ipp"
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "constructor_injection.hpp"
+#include "activation_context.hpp"
+#include "instance_activator.hpp"
+#include "factory.hpp"
+#include "lazy.hpp"
+
+
+namespace di {
+
+template <typename T>
+template <size_t index>
+inline constructor_injection<T>::argument<index>::argument(
+        const constructor_injection& injection,
+        const activation_context& context)
+    :
+        injection_(injection),
+        context_(context)
+{
+
+}
+
+template <typename T>
+template <size_t index>
+template <typename U, typename>
+inline constructor_injection<T>::argument<index>::operator U() const
+{
+    return injection_.template activate<std::decay_t<U>, index>(context_);
+}
+
+template <typename T>
+inline constructor_injection<T>::constructor_injection()
+    : state_(std::make_shared<state>())
+{
+    for (auto& binding : state_->bindings)
+        binding.store(nullptr);
+}
+
+template <typename T>
+inline T* constructor_injection<T>::operator()(const activation_context& context) const
+{
+    return create(
+            context,
+            std::make_index_sequence<arity>(),
+            std::integral_constant<bool, has_inject<T>::value>());
+}
+
+template <typename T>
+inline std::vector<definition::dependency> constructor_injection<T>::dependencies()
+{
+    return dependencies(
+            std::make_index_sequence<arity>(),
+            std::integral_constant<bool, has_inject<T>::value>());
+}
+
+template <typename T>
+template <size_t... indexes>
+inline std::vector<definition::dependency> constructor_injection<T>::dependencies(
+        std::index_sequence<indexes...>,
+        std::true_type)
+{
+    using parameters_type = declared<typename T::inject>;
+    return { dependency(tag<typename parameters_type::template parameter<indexes>>())... };
+}
+
+template <typename T>
+template <size_t... indexes>
+inline std::vector<definition::dependency> constructor_injection<T>::dependencies(
+        std::index_sequence<indexes...>,
+        std::false_type)
+{
+    return {};
+}
+
+template <typename T>
+template <typename D>
+inline definition::dependency constructor_injection<T>::dependency(tag<std::unique_ptr<D>>)
+{
+    return definition::make_dependency<D>(definition::default_id, false);
+}
+
+template <typename T>
+template <typename D>
+inline definition::dependency constructor_injection<T>::dependency(tag<std::shared_ptr<D>>)
+{
+    return definition::make_dependency<D>(definition::default_id, false);
+}
+
+template <typename T>
+template <typename D, typename... args_types>
+inline definition::dependency constructor_injection<T>::dependency(tag<factory<D(args_types...)>>)
+{
+    return definition::make_dependency<D, args_types...>(definition::default_id, true);
+}
+
+template <typename T>
+template <typename D>
+inline definition::dependency constructor_injection<T>::dependency(tag<lazy<D>>)
+{
+    return definition::make_dependency<D>(definition::default_id, true);
+}
+
+template <typename T>
+template <typename D>
+inline definition::dependency constructor_injection<T>::dependency(tag<D>)
+{
+    return definition::make_dependency<D>(definition::default_id, false);
+}
+
+template <typename T>
+template <size_t... indexes>
+inline T* constructor_injection<T>::create(
+        const activation_context& context,
+        std::index_sequence<indexes...>,
+        std::true_type) const
+{
+    using parameters_type = declared<typename T::inject>;
+    return new T(activate<typename parameters_type::template parameter<indexes>, indexes>(context)...);
+}
+
+template <typename T>
+template <size_t... indexes>
+inline T* constructor_injection<T>::create(
+        const activation_context& context,
+        std::index_sequence<indexes...> sequence,
+        std::false_type) const
+{
+    static_assert(
+            traits::constructible,
+            "T can't be constructed from its dependencies, declare its constructor parameters with T::inject!");
+
+    return create_detected(context, sequence, std::integral_constant<bool, traits::braced>());
+}
+
+template <typename T>
+template <size_t... indexes>
+inline T* constructor_injection<T>::create_detected(
+        const activation_context& context,
+        std::index_sequence<indexes...>,
+        std::true_type) const
+{
+    return new T { argument<indexes>(*this, context)... };
+}
+
+template <typename T>
+template <size_t... indexes>
+inline T* constructor_injection<T>::create_detected(
+        const activation_context& context,
+        std::index_sequence<indexes...>,
+        std::false_type) const
+{
+    return new T(argument<indexes>(*this, context)...);
+}
+
+template <typename T>
+template <typename U, size_t index>
+inline U constructor_injection<T>::activate(const activation_context& context) const
+{
+    return resolve<index>(context, tag<U>());
+}
+
+template <typename T>
+template <size_t index, typename D>
+inline std::unique_ptr<D> constructor_injection<T>::resolve(
+        const activation_context& context,
+        tag<std::unique_ptr<D>>) const
+{
+    auto& binding = bound<D, index>(context);
+
+    activation_context child(definition::default_id, "", context);
+    return context.activator_.template activate_unique<D>(binding, child);
+}
+
+template <typename T>
+template <size_t index, typename D>
+inline std::shared_ptr<D> constructor_injection<T>::resolve(
+        const activation_context& context,
+        tag<std::shared_ptr<D>>) const
+{
+    auto& binding = bound<D, index>(context);
+
+    activation_context child(definition::default_id, "", context);
+    return context.activator_.template activate_shared<D>(binding, child);
+}
+
+template <typename T>
+template <size_t index, typename D, typename... args_types>
+inline factory<D(args_types...)> constructor_injection<T>::resolve(
+        const activation_context& context,
+        tag<factory<D(args_types...)>>) const
+{
+    auto& binding = bound<D, index, args_types...>(context);
+
+    return factory<D(args_types...)>(context.activator_.template resolve<D, args_types...>(binding));
+}
+
+template <typename T>
+template <size_t index, typename D>
+inline lazy<D> constructor_injection<T>::resolve(
+        const activation_context& context,
+        tag<lazy<D>>) const
+{
+    auto& binding = bound<D, index>(context);
+
+    return lazy<D>(context.activator_.template resolve<D>(binding), context.annotations_);
+}
+
+template <typename T>
+template <size_t index, typename D>
+inline D constructor_injection<T>::resolve(
+        const activation_context& context,
+        tag<D>) const
+{
+    auto& binding = bound<D, index>(context);
+
+    activation_context child(definition::default_id, "", context);
+    return context.activator_.template activate_raii<D>(binding, child);
+}
+
+template <typename T>
+template <typename D, size_t index, typename... args_types>
+inline const definition::binding<D, args_types...>& constructor_injection<T>::bound(
+        const activation_context& context) const
+{
+    auto& cached = state_->bindings[index];
+
+    auto binding = cached.load(std::memory_order_acquire);
+    if (!binding)
+    {
+        auto& found = context.activator_.template find<D, args_types...>(definition::default_id);
+        binding = &found.second.template bound<D, args_types...>();
+        cached.store(binding, std::memory_order_release);
+    }
+
+    return *static_cast<const definition::binding<D, args_types...>*>(binding);
+}
+
+}
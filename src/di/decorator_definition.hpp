@@ -4,6 +4,7 @@
 
 #include <boost/any.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <typeindex>
@@ -22,12 +23,77 @@ public:
     struct combined_identity
     { };
 
+    /**
+     * @brief Way in which a decorator is applied.
+     */
+    enum class decoration_type
+    {
+        /**
+         * @brief Decorator creates a new instance wrapping the decorated one.
+         */
+        pointer,
+        /**
+         * @brief Decorator transforms the decorated value, applied in place of the decorated instance.
+         */
+        value,
+        /**
+         * @brief Decorator type derived from the decorated type, consecutive layers share a single allocation.
+         */
+        layer
+    };
+
+    /**
+     * @brief A layered decorator type, constructible in place from a reference to the decorated instance.
+     * @tparam T Decorated type.
+     */
+    template <typename T>
+    struct layer_type
+    {
+        size_t size;
+        size_t alignment;
+        T* (*construct)(void* storage, T& undecorated);
+        void (*destroy)(T* layer);
+    };
+
     using id_type = std::type_index;
     using map_type = std::unordered_multimap<id_type, decorator_definition>;
 
     template <typename decorator_type, typename deleter_type>
     explicit decorator_definition(decorator_type&& decorator, deleter_type&& deleter);
 
+    /**
+     * @brief Creates a definition of a value decorator of T.
+     */
+    template <typename T>
+    static decorator_definition make_value(std::function<T(T&&, const activation_context&)>&& decorator);
+
+    /**
+     * @brief Creates a definition of a layered decorator of T.
+     * @tparam decorator_type A type derived from T, constructible from **T&**.
+     */
+    template <typename T, typename decorator_type>
+    static decorator_definition make_layer();
+
+    /**
+     * @brief Constructs layers of consecutive layered decorators in a single allocation.
+     * @details
+     * The first layer decorates the undecorated instance, each following layer decorates the previous one. Returned
+     * outermost layer is released with the deleter of any of layered decorators, which destroys all layers and releases
+     * the undecorated instance with given deleter.
+     *
+     * @param undecorated Decorated instance.
+     * @param deleter Deleter of the decorated instance, **delete** is used when empty.
+     * @param first First layered decorator.
+     * @param last Past the last layered decorator.
+     * @return Outermost layer.
+     */
+    template <typename T>
+    static T* compose_layers(
+            T* undecorated,
+            const std::function<void(T*)>& deleter,
+            const decorator_definition* const* first,
+            const decorator_definition* const* last);
+
     /**
      * @brief Non-copy constructable.
      */
@@ -48,9 +114,17 @@ public:
     template <typename T>
     static id_type make_id();
 
+    decoration_type type() const;
+
     template <typename T>
     const std::function<T*(T*, const activation_context&)>& decorator() const;
 
+    template <typename T>
+    const std::function<T(T&&, const activation_context&)>& value_decorator() const;
+
+    template <typename T>
+    const layer_type<T>& layer() const;
+
     /**
      * @brief Gets delete method defining a way how decorator should be deallocated.
      * @tparam T A type of decorator to delete.
@@ -59,9 +133,58 @@ public:
     template <typename T>
     const std::function<void(T*)>& deleter() const;
 
+    /**
+     * @brief Restricts this decorator to the definition registered under given id.
+     * @details
+     * Scope is evaluated once for each definition of T when **instance_activator** is constructed.
+     */
+    decorator_definition& for_id(const std::string& id);
+
+    /**
+     * @brief Restricts this decorator to definitions which ids satisfy predicate_type.
+     * @tparam predicate_type Default constructable functor invoked with an id of a definition.
+     */
+    template <typename predicate_type>
+    decorator_definition& when();
+
+    /**
+     * @brief Checks whether this decorator applies to the definition registered under given id.
+     */
+    bool applies_to(const std::string& id) const;
+
 private:
+    template <typename T>
+    struct layers_header
+    {
+        T* undecorated;
+        std::function<void(T*)> deleter;
+        size_t count;
+    };
+
+    template <typename T>
+    struct layer_entry
+    {
+        T* layer;
+        void (*destroy)(T* layer);
+    };
+
+    struct layers_trailer
+    {
+        void* block;
+    };
+
+    static size_t align(size_t offset, size_t alignment);
+
+    template <typename T>
+    static size_t entries_offset();
+
+    template <typename T>
+    static void release_layers(T* outermost);
+
+    decoration_type type_;
     boost::any decorator_;
     boost::any deleter_;
+    std::function<bool(const std::string&)> scope_;
 
 };
 
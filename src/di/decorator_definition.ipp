@@ -3,16 +3,155 @@
 #include "decorator_definition.hpp"
 #include "definition.hpp"
 
+#include <memory>
+#include <new>
+#include <type_traits>
+
 
 namespace di {
 
 template <typename decorator_type, typename deleter_type>
 inline decorator_definition::decorator_definition(decorator_type&& decorator, deleter_type&& deleter)
     :
+        type_(decoration_type::pointer),
         decorator_(std::move(decorator)),
-        deleter_(std::move(deleter))
+        deleter_(std::move(deleter)),
+        scope_()
+{
+
+}
+
+template <typename T>
+inline decorator_definition decorator_definition::make_value(
+        std::function<T(T&&, const activation_context&)>&& decorator)
+{
+    decorator_definition definition(std::move(decorator), std::function<void(T*)>());
+    definition.type_ = decoration_type::value;
+
+    return definition;
+}
+
+template <typename T, typename decorator_type>
+inline decorator_definition decorator_definition::make_layer()
+{
+    static_assert(
+            std::is_polymorphic<T>::value,
+            "T has to be polymorphic!");
+    static_assert(
+            std::is_base_of<T, decorator_type>::value,
+            "decorator_type has to derive from T!");
+    static_assert(
+            std::is_constructible<decorator_type, T&>::value,
+            "decorator_type has to be constructible from T&!");
+    static_assert(
+            alignof(decorator_type) <= alignof(std::max_align_t),
+            "decorator_type can't be over-aligned!");
+
+    layer_type<T> layer {
+        sizeof(decorator_type),
+        alignof(decorator_type),
+        [](void* storage, T& undecorated) -> T*
+        {
+            return new (storage) decorator_type(undecorated);
+        },
+        [](T* layer)
+        {
+            static_cast<decorator_type*>(layer)->~decorator_type();
+        }
+    };
+
+    decorator_definition definition(std::move(layer), std::function<void(T*)>(&release_layers<T>));
+    definition.type_ = decoration_type::layer;
+
+    return definition;
+}
+
+template <typename T>
+inline T* decorator_definition::compose_layers(
+        T* undecorated,
+        const std::function<void(T*)>& deleter,
+        const decorator_definition* const* first,
+        const decorator_definition* const* last)
 {
+    auto count = static_cast<size_t>(last - first);
+
+    // the outermost layer follows the trailer, inner layers follow it
+    auto offset = entries_offset<T>() + count * sizeof(layer_entry<T>) + sizeof(layers_trailer);
+    std::unique_ptr<size_t[]> offsets(new size_t[count]);
+    for (auto i = count; i > 0u; i--)
+    {
+        auto& layer = first[i - 1u]->template layer<T>();
+        offset = align(offset, layer.alignment);
+        offsets[i - 1u] = offset;
+        offset += layer.size;
+    }
+
+    auto block = static_cast<char*>(::operator new(offset));
+    auto header = new (block) layers_header<T> { undecorated, deleter, 0u };
+    auto entries = reinterpret_cast<layer_entry<T>*>(block + entries_offset<T>());
 
+    T* decorated = undecorated;
+    try
+    {
+        for (auto i = 0u; i < count; i++)
+        {
+            auto& layer = first[i]->template layer<T>();
+            decorated = layer.construct(block + offsets[i], *decorated);
+            entries[i] = { decorated, layer.destroy };
+            header->count++;
+        }
+    }
+    catch (...)
+    {
+        for (auto i = header->count; i > 0u; i--)
+            entries[i - 1u].destroy(entries[i - 1u].layer);
+
+        header->~layers_header<T>();
+        ::operator delete(block);
+        throw;
+    }
+
+    auto trailer = reinterpret_cast<layers_trailer*>(block + offsets[count - 1u] - sizeof(layers_trailer));
+    trailer->block = block;
+
+    return decorated;
+}
+
+template <typename T>
+inline void decorator_definition::release_layers(T* outermost)
+{
+    auto storage = static_cast<char*>(dynamic_cast<void*>(outermost));
+    auto block = reinterpret_cast<layers_trailer*>(storage - sizeof(layers_trailer))->block;
+
+    auto header = reinterpret_cast<layers_header<T>*>(block);
+    auto entries = reinterpret_cast<layer_entry<T>*>(static_cast<char*>(block) + entries_offset<T>());
+
+    for (auto i = header->count; i > 0u; i--)
+        entries[i - 1u].destroy(entries[i - 1u].layer);
+
+    if (header->deleter)
+        header->deleter(header->undecorated);
+    else
+        delete header->undecorated;
+
+    header->~layers_header<T>();
+    ::operator delete(block);
+}
+
+inline size_t decorator_definition::align(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1u) / alignment * alignment;
+}
+
+template <typename T>
+inline size_t decorator_definition::entries_offset()
+{
+    return align(sizeof(layers_header<T>), alignof(layer_entry<T>));
+}
+
+inline decorator_definition::decoration_type decorator_definition::type() const
+{
+    return type_;
 }
 
 template <typename T>
@@ -28,6 +167,19 @@ inline const std::function<T*(T*, const activation_context&)>& decorator_definit
     return boost::any_cast<const decorator_function_type&>(decorator_);
 }
 
+template <typename T>
+inline const std::function<T(T&&, const activation_context&)>& decorator_definition::value_decorator() const
+{
+    using decorator_function_type = std::function<T(T&&, const activation_context&)>;
+    return boost::any_cast<const decorator_function_type&>(decorator_);
+}
+
+template <typename T>
+inline const decorator_definition::layer_type<T>& decorator_definition::layer() const
+{
+    return boost::any_cast<const layer_type<T>&>(decorator_);
+}
+
 template <typename T>
 inline const std::function<void(T*)>& decorator_definition::deleter() const
 {
@@ -35,4 +187,26 @@ inline const std::function<void(T*)>& decorator_definition::deleter() const
     return boost::any_cast<const deleter_function_type&>(deleter_);
 }
 
+inline decorator_definition& decorator_definition::for_id(const std::string& id)
+{
+    scope_ = [id](const std::string& other)
+    {
+        return other == id;
+    };
+
+    return *this;
+}
+
+template <typename predicate_type>
+inline decorator_definition& decorator_definition::when()
+{
+    scope_ = predicate_type();
+    return *this;
+}
+
+inline bool decorator_definition::applies_to(const std::string& id) const
+{
+    return !scope_ || scope_(id);
+}
+
 }
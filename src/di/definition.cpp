@@ -1,8 +1,80 @@
 #include "definition.hpp"
 
+#include <string>
+#include <typeindex>
+#include <vector>
+
+
+using namespace std;
+
 
 namespace di {
 
+void definition::bind(
+        const string& id,
+        const interceptor_definition::map_type& interceptors,
+        const decorator_definition::map_type& decorators)
+{
+    binder_(*this, id, interceptors, decorators);
+    for (auto& handler : bound_handlers_)
+        handler(*this);
+}
+
+void definition::define_initializer(initializer_type&& initializer)
+{
+    initializer_ = std::move(initializer);
+}
+
+const definition::initializer_type& definition::initializer() const
+{
+    return initializer_;
+}
+
+void definition::define_bound_handler(bound_handler_type&& handler)
+{
+    bound_handlers_.push_back(std::move(handler));
+}
+
+void definition::define_dependency(dependency&& dependency)
+{
+    dependencies_.push_back(std::move(dependency));
+}
+
+const vector<definition::dependency>& definition::dependencies() const
+{
+    return dependencies_;
+}
+
+const type_index& definition::type() const
+{
+    return type_;
+}
+
+const vector<type_index>& definition::arguments() const
+{
+    return arguments_;
+}
+
+size_t definition::interceptors_count() const
+{
+    return interceptors_count_;
+}
+
+size_t definition::decorators_count() const
+{
+    return decorators_count_;
+}
+
+bool definition::has_lifetime() const
+{
+    return !lifetime_.empty();
+}
+
+const shared_ptr<activation_statistics>& definition::statistics() const
+{
+    return statistics_;
+}
+
 annotations_map& definition::annotations()
 {
     return annotations_;
@@ -1,21 +1,28 @@
 #pragma once
 
+#include "activation_statistics.hpp"
 #include "annotations_map.hpp"
+#include "decorator_definition.hpp"
+#include "interceptor_definition.hpp"
 
+#include <di/tools/function_ref.hpp>
 #include <di/tools/hash.hpp>
 
 #include <boost/any.hpp>
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 namespace di {
 
 class activation_context;
+class instance_activator;
 
 class definition
 {
@@ -24,13 +31,93 @@ public:
     struct combined_identity
     { };
 
+    template <typename T>
+    struct identity
+    {
+        using type = T;
+    };
+
     using id_type = std::pair<std::string, std::type_index>;
     using map_type = std::unordered_map<id_type, definition, tools::pair_hash>;
 
+    /**
+     * @brief A lifetime governing shared activation of a definition.
+     * @details
+     * A lifetime receives activation context, activation arguments and a callback creating a new shared instance.
+     * It decides whether to return an existing instance or to create a new one.
+     */
+    template <typename T, typename... args_types>
+    using lifetime_type = std::function<std::shared_ptr<T>(
+            activation_context&,
+            args_types...,
+            tools::function_ref<std::shared_ptr<T>()>)>;
+
+    using initializer_type = std::function<void(const instance_activator&)>;
+    using bound_handler_type = std::function<void(const definition&)>;
+
+    /**
+     * @brief A factory creating instances of a definition by value, without allocating them.
+     */
+    template <typename T, typename... args_types>
+    using value_creator_type = std::function<T(const activation_context&, args_types...)>;
+
+    /**
+     * @brief Creator, deleter, interceptors and decorators of a definition resolved once by the activator.
+     * @details
+     * A binding is established for each definition when **instance_activator** is constructed. It references
+     * functors owned by the activator, hence it remains valid for as long as the owning activator is alive. The value
+     * creator is only available to definitions registered with a factory returning T by value.
+     *
+     * Each deleter an activated instance can end up with - the deleter of the definition or of any of its decorators -
+     * has a tracked counterpart recording the release of the instance in statistics of the definition.
+     *
+     * @tparam T Registered type.
+     * @tparam args_types Registered activation arguments.
+     */
+    template <typename T, typename... args_types>
+    struct binding
+    {
+        using creator_type = std::function<T*(const activation_context&, args_types...)>;
+        using deleter_type = std::function<void(T*)>;
+        using interceptor_type = std::function<void(T&, const activation_context&, args_types...)>;
+
+        definition* owner;
+        const std::string* id;
+        const creator_type* creator;
+        const value_creator_type<T, args_types...>* value_creator;
+        const deleter_type* deleter;
+        const lifetime_type<T, args_types...>* lifetime;
+        std::vector<const interceptor_type*> interceptors;
+        std::vector<const async_dispatcher::handler_type*> async_interceptors;
+        std::vector<const decorator_definition*> decorators;
+        std::vector<std::pair<const deleter_type*, deleter_type>> tracked_deleters;
+
+        /**
+         * @brief Gets the tracked counterpart of a deleter of this binding.
+         */
+        const deleter_type& tracked(const deleter_type& deleter) const;
+    };
+
+    /**
+     * @brief A dependency declared by a definition, validated when the activator is constructed.
+     * @details
+     * A deferred dependency (a factory or a lazy dependency) has to be defined, but it isn't activated together with
+     * the declaring definition, hence it can't take part in a cycle.
+     */
+    struct dependency
+    {
+        id_type id;
+        std::type_index type;
+        std::string description;
+        bool deferred;
+    };
+
     static constexpr auto default_id = "";
 
-    template <typename creator_type, typename deleter_type>
-    explicit definition(creator_type&& creator, deleter_type&& deleter);
+    template <typename T, typename... args_types>
+    explicit definition(
+            std::function<T*(const activation_context&, args_types...)>&& creator,
+            std::function<void(T*)>&& deleter);
 
     /**
      * @brief Non-copy constructable.
@@ -52,17 +139,103 @@ public:
     template <typename T, typename... args_types>
     static id_type make_id(const std::string& id);
 
+    template <typename T, typename... args_types>
+    static dependency make_dependency(const std::string& id, bool deferred);
+
+    /**
+     * @brief Type registered by this definition, regardless of its activation arguments.
+     */
+    const std::type_index& type() const;
+
+    /**
+     * @brief Activation argument types of this definition.
+     */
+    const std::vector<std::type_index>& arguments() const;
+
     template <typename return_type, typename... args_types>
     const std::function<return_type*(const activation_context&, args_types...)>& creator() const;
 
     template <typename T>
     const std::function<void(T*)>& deleter() const;
 
+    /**
+     * @brief Defines a factory creating instances of this definition by value, used in place of the creator where
+     * instances don't have to be allocated.
+     */
+    template <typename T, typename... args_types>
+    void define_value_creator(
+            typename identity<std::shared_ptr<const value_creator_type<T, args_types...>>>::type value_creator);
+
+    /**
+     * @brief Resolves creator, deleter, interceptors and decorators applicable to this definition.
+     * @param id Id under which this definition is registered, matched against scopes of interceptors and decorators.
+     * @param interceptors Interceptors available to the activator.
+     * @param decorators Decorators available to the activator.
+     */
+    void bind(
+            const std::string& id,
+            const interceptor_definition::map_type& interceptors,
+            const decorator_definition::map_type& decorators);
+
+    /**
+     * @brief Defines a lifetime applied when this definition is activated as a shared instance.
+     */
+    template <typename T, typename... args_types>
+    void define_lifetime(typename identity<lifetime_type<T, args_types...>>::type&& lifetime);
+
+    /**
+     * @brief Defines an initializer invoked when the activator owning this definition is constructed.
+     */
+    void define_initializer(initializer_type&& initializer);
+
+    const initializer_type& initializer() const;
+
+    /**
+     * @brief Defines a handler invoked each time this definition is bound by an activator.
+     */
+    void define_bound_handler(bound_handler_type&& handler);
+
+    /**
+     * @brief Declares a dependency of this definition.
+     */
+    void define_dependency(dependency&& dependency);
+
+    const std::vector<dependency>& dependencies() const;
+
+    template <typename T, typename... args_types>
+    const binding<T, args_types...>& bound() const;
+
+    size_t interceptors_count() const;
+
+    size_t decorators_count() const;
+
+    bool has_lifetime() const;
+
+    const std::shared_ptr<activation_statistics>& statistics() const;
+
     annotations_map& annotations();
 
 private:
+    using binder_type = std::function<void(
+            definition&,
+            const std::string&,
+            const interceptor_definition::map_type&,
+            const decorator_definition::map_type&)>;
+
+    std::type_index type_;
+    std::vector<std::type_index> arguments_;
     boost::any creator_;
+    boost::any value_creator_;
     boost::any deleter_;
+    boost::any binding_;
+    binder_type binder_;
+    boost::any lifetime_;
+    initializer_type initializer_;
+    std::vector<bound_handler_type> bound_handlers_;
+    std::vector<dependency> dependencies_;
+    size_t interceptors_count_;
+    size_t decorators_count_;
+    std::shared_ptr<activation_statistics> statistics_;
 
     annotations_map annotations_;
 
@@ -2,14 +2,109 @@
 
 #include "definition.hpp"
 
+#include <di/tools/cxxabi_utils.hpp>
+#include <di/tools/traits/veriadic_traits.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
 
 namespace di {
 
-template <typename creator_type, typename deleter_type>
-inline definition::definition(creator_type&& creator, deleter_type&& deleter)
+template <typename T, typename... args_types>
+inline definition::definition(
+        std::function<T*(const activation_context&, args_types...)>&& creator,
+        std::function<void(T*)>&& deleter)
     :
+        type_(typeid(T)),
+        arguments_ { std::type_index(typeid(args_types))... },
         creator_(std::move(creator)),
-        deleter_(std::move(deleter))
+        value_creator_(),
+        deleter_(std::move(deleter)),
+        binding_(),
+        binder_([](
+                definition& self,
+                const std::string& id,
+                const interceptor_definition::map_type& interceptors,
+                const decorator_definition::map_type& decorators)
+        {
+            using lifetime_function_type = lifetime_type<T, args_types...>;
+            using value_creator_pointer_type = std::shared_ptr<const value_creator_type<T, args_types...>>;
+
+            binding<T, args_types...> bound {
+                &self,
+                &id,
+                &self.template creator<T, args_types...>(),
+                self.value_creator_.empty()
+                        ? nullptr
+                        : boost::any_cast<const value_creator_pointer_type&>(self.value_creator_).get(),
+                &self.template deleter<T>(),
+                self.lifetime_.empty() ? nullptr : &boost::any_cast<const lifetime_function_type&>(self.lifetime_),
+                {},
+                {},
+                {},
+                {}
+            };
+
+            auto interceptor_id = interceptor_definition::make_id<T, args_types...>();
+            auto interceptor_range = interceptors.equal_range(interceptor_id);
+            for (auto iter = interceptor_range.first; iter != interceptor_range.second; ++iter)
+            {
+                if (!iter->second.applies_to(id))
+                    continue;
+
+                if (iter->second.asynchronous())
+                    bound.async_interceptors.push_back(&iter->second.async_interceptor());
+                else
+                    bound.interceptors.push_back(&iter->second.template interceptor<T&, args_types...>());
+            }
+
+            auto decorator_id = decorator_definition::make_id<T>();
+            auto decorator_range = decorators.equal_range(decorator_id);
+            for (auto iter = decorator_range.first; iter != decorator_range.second; ++iter)
+            {
+                if (iter->second.applies_to(id))
+                    bound.decorators.push_back(&iter->second);
+            }
+
+            // layered decorators are applied last, in a single allocation owned by the outermost layer
+            std::stable_partition(
+                    bound.decorators.begin(),
+                    bound.decorators.end(),
+                    [](const decorator_definition* decorator)
+                    {
+                        return decorator->type() != decorator_definition::decoration_type::layer;
+                    });
+
+            auto track = [&bound, statistics = self.statistics_](const std::function<void(T*)>* deleter)
+            {
+                bound.tracked_deleters.emplace_back(deleter, [deleter = *deleter, statistics](T* instance)
+                {
+                    if (deleter)
+                        deleter(instance);
+                    else
+                        delete instance;
+
+                    statistics->record_release(sizeof(T));
+                });
+            };
+
+            track(bound.deleter);
+            for (auto decorator : bound.decorators)
+                track(&decorator->template deleter<T>());
+
+            self.interceptors_count_ = bound.interceptors.size() + bound.async_interceptors.size();
+            self.decorators_count_ = bound.decorators.size();
+            self.binding_ = std::move(bound);
+        }),
+        lifetime_(),
+        initializer_(),
+        bound_handlers_(),
+        dependencies_(),
+        interceptors_count_(0u),
+        decorators_count_(0u),
+        statistics_(std::make_shared<activation_statistics>())
 {
 
 }
@@ -21,6 +116,28 @@ inline definition::id_type definition::make_id(const std::string& id)
     return std::make_pair(id, std::type_index(typeid(signature_type)));
 }
 
+template <typename T, typename... args_types>
+inline definition::dependency definition::make_dependency(const std::string& id, bool deferred)
+{
+    std::stringstream description;
+    description << tools::demangle(typeid(T).name());
+
+    auto args_count = sizeof...(args_types);
+    if (args_count > 0u)
+    {
+        description << "(";
+        for (size_t i = 0u; i < args_count; i++)
+        {
+            if (i > 0u)
+                description << ", ";
+            description << tools::demangle(tools::argument_types<args_types...>::name(i));
+        }
+        description << ")";
+    }
+
+    return { make_id<T, args_types...>(id), std::type_index(typeid(T)), description.str(), deferred };
+}
+
 template <typename return_type, typename... args_types>
 inline const std::function<return_type*(const activation_context&, args_types...)>& definition::creator() const
 {
@@ -35,5 +152,36 @@ inline const std::function<void(T*)>& definition::deleter() const
     return boost::any_cast<const deleter_function_type&>(deleter_);
 }
 
+template <typename T, typename... args_types>
+inline void definition::define_value_creator(
+        typename identity<std::shared_ptr<const value_creator_type<T, args_types...>>>::type value_creator)
+{
+    value_creator_ = std::move(value_creator);
+}
+
+template <typename T, typename... args_types>
+inline void definition::define_lifetime(typename identity<lifetime_type<T, args_types...>>::type&& lifetime)
+{
+    lifetime_ = std::move(lifetime);
+}
+
+template <typename T, typename... args_types>
+inline const definition::binding<T, args_types...>& definition::bound() const
+{
+    return boost::any_cast<const binding<T, args_types...>&>(binding_);
+}
+
+template <typename T, typename... args_types>
+inline auto definition::binding<T, args_types...>::tracked(const deleter_type& deleter) const -> const deleter_type&
+{
+    for (auto& tracked_deleter : tracked_deleters)
+    {
+        if (tracked_deleter.first == &deleter)
+            return tracked_deleter.second;
+    }
+
+    throw std::logic_error("Deleter isn't bound to the definition!");
+}
+
 }
 
@@ -4,12 +4,15 @@
 #include "decorator_definition.hpp"
 #include "interceptor_definition.hpp"
 #include "activation_context.hpp"
+#include "constructor_injection.hpp"
+#include "lifetime.hpp"
 
 #include <di/tools/hash.hpp>
 
 #include <boost/any.hpp>
 
 #include <functional>
+#include <future>
 #include <list>
 #include <string>
 #include <typeindex>
@@ -50,6 +53,22 @@ public:
         template <typename... annotation_types>
         registration& annotate(annotation_types&&... annotations);
 
+        template <typename D, typename... dependency_args_types>
+        registration& depends_on(const std::string& id = definition::default_id);
+
+        template <typename D, typename... dependency_args_types>
+        registration& depends_lazily_on(const std::string& id = definition::default_id);
+
+        registration& single_instance();
+
+        registration& memoized(size_t capacity, size_t shards_count = 16u);
+
+        registration& weak_instance();
+
+        registration& per_cpu(size_t shards_count = 0u);
+
+        registration& eager();
+
         operator definition&();
 
     private:
@@ -181,6 +200,78 @@ public:
     registration<T, args_types...> define_default(
             typename identity<std::function<std::unique_ptr<T>(args_types...)>>::type&& factory);
 
+    /**
+     * @brief Defines a component constructed with its dependencies injected into its constructor.
+     * @details
+     * No factory is required, constructor parameters of T are either declared with **T::inject** or detected from
+     * the constructor with the greatest number of class type parameters. Each parameter is activated from its default
+     * definition, for instance:
+     * @code
+     * class engine
+     * {
+     * public:
+     *      engine(configuration configuration, std::unique_ptr<storage> storage, lazy<network> network);
+     * };
+     *
+     * definition_builder builder;
+     * builder.define_type<engine>("engine");
+     * @endcode
+     * Definitions of the parameters are resolved on the first activation of T and reused by all later activations.
+     *
+     * @tparam T Component type.
+     * @param id An identifier under which the component is being registered
+     * @return An instance of **registration** allowing further customisation of registered definition.
+     */
+    template <typename T>
+    registration<T> define_type(const std::string& id);
+
+    template <typename T>
+    registration<T> define_type();
+
+    /**
+     * @brief Defines an asynchronous component factory with a unique key.
+     * @details
+     * The factory starts creation of the component, for instance an I/O bound initialisation, and returns a future of
+     * it. The definition can be activated in any way, activation waits for the future executing pending asynchronous
+     * activations in the meantime. For instance:
+     * @code
+     * definition_builder builder;
+     * builder.define_async<configuration>("file", [](const activation_context& context) -> future<configuration>
+     * {
+     *      return std::async(std::launch::async, []()
+     *      {
+     *          return load_configuration("config.json");
+     *      });
+     * });
+     *
+     * instance_activator activator(std::move(builder));
+     * auto pending = activator.activate_async<configuration>("file");
+     * @endcode
+     *
+     * @tparam T Component type for which the factory is being registered.
+     * @tparam args_types Types of arguments required by the registered factory.
+     * @param id An identifier under which the factory is being registered
+     * @param factory Factory functor returning a future of T.
+     * @return An instance of **registration** allowing further customisation of registered definition.
+     */
+    template <typename T, typename... args_types>
+    registration<T, args_types...> define_async(
+            const std::string& id,
+            typename identity<std::function<std::future<T>(const activation_context&, args_types...)>>::type&& factory);
+
+    template <typename T, typename... args_types>
+    registration<T, args_types...> define_async(
+            const std::string& id,
+            typename identity<std::function<std::future<T>(args_types...)>>::type&& factory);
+
+    template <typename T, typename... args_types>
+    registration<T, args_types...> define_default_async(
+            typename identity<std::function<std::future<T>(const activation_context&, args_types...)>>::type&& factory);
+
+    template <typename T, typename... args_types>
+    registration<T, args_types...> define_default_async(
+            typename identity<std::function<std::future<T>(args_types...)>>::type&& factory);
+
     /**
      * @brief Defines static method or C style function as a type factory under unique registration id.
      * @details
@@ -498,37 +589,58 @@ public:
             class_type* instance);
 
     template <typename T, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             typename identity<std::function<void(T& activated, const activation_context&, args_types...)>>::type&& interceptor);
 
     template <typename T, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             typename identity<std::function<void(const activation_context&, args_types...)>>::type&& interceptor);
 
     template <typename T, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             typename identity<std::function<void(args_types...)>>::type&& interceptor);
 
     template <typename T, typename class_type, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             void (class_type::*interceptor)(T&, const activation_context&, args_types...),
             class_type* instance);
 
     template <typename T, typename class_type, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             void (class_type::*interceptor)(T&, args_types...),
             class_type* instance);
 
     template <typename T, typename class_type, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             void (class_type::*interceptor)(const activation_context&, args_types...),
             class_type* instance);
 
     template <typename T, typename class_type, typename... args_types>
-    const interceptor_definition& define_interceptor(
+    interceptor_definition& define_interceptor(
             void (class_type::*interceptor)(args_types...),
             class_type* instance);
 
+    /**
+     * @brief Defines an interceptor invoked asynchronously after an instance of T is activated.
+     * @details
+     * Activation posts an event into a bounded lock-free queue drained on a background thread of the activator, hence
+     * the interceptor doesn't add to the activation latency. It receives neither the activated instance nor activation
+     * arguments, only the id and type of the activated definition. Events posted into a full queue are dropped, see
+     * **instance_activator::dropped_interceptions**. For instance:
+     * @code
+     * builder.define_async_interceptor<connection>([&log](const interception_event& event)
+     * {
+     *      log << "activated " << event.id << std::endl;
+     * });
+     * @endcode
+     *
+     * @tparam T Intercepted type.
+     * @tparam args_types Activation arguments of intercepted definitions.
+     * @param interceptor Interceptor invoked on the background thread.
+     */
+    template <typename T, typename... args_types>
+    interceptor_definition& define_async_interceptor(async_dispatcher::handler_type&& interceptor);
+
     /**
      * @brief Defines a decorator for activated instance of T.
      * @details
@@ -550,7 +662,7 @@ public:
      * @param deleter A deleter function defining a way how created decorator should be disposed.
      */
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             typename identity<std::function<T*(T* activated, const activation_context&)>>::type&& decorator,
             typename identity<std::function<void(T*)>>::type&& deleter);
 
@@ -572,7 +684,7 @@ public:
      * @param deleter A deleter function defining a way how created decorator should be disposed.
      */
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             typename identity<std::function<T*(T* activated)>>::type&& decorator,
             typename identity<std::function<void(T*)>>::type&& deleter);
 
@@ -598,7 +710,7 @@ public:
      * @param deleter A deleter function defining a way how created decorator should be disposed.
      */
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             typename identity<std::function<
                     std::unique_ptr<T>(std::unique_ptr<T>&& activated, const activation_context&)>>::type&& decorator);
 
@@ -621,7 +733,7 @@ public:
      * @param deleter A deleter function defining a way how created decorator should be disposed.
      */
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             typename identity<std::function<
                     std::unique_ptr<T>(std::unique_ptr<T>&& activated)>>::type&& decorator);
 
@@ -694,7 +806,7 @@ public:
      * @param deleter A deleter function defining a way how created decorator should be disposed.
      */
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             typename identity<std::function<T(T&& activated, const activation_context&)>>::type&& decorator);
 
     /**
@@ -766,37 +878,66 @@ public:
      * @param deleter A deleter function defining a way how created decorator should be disposed.
      */
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             typename identity<std::function<T(T&& activated)>>::type&& decorator);
 
     template <typename T, typename class_type>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             std::unique_ptr<T> (class_type::*decorator)(std::unique_ptr<T>&&, const activation_context&),
             class_type* instance);
 
     template <typename T, typename class_type>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             std::unique_ptr<T> (class_type::*decorator)(std::unique_ptr<T>&&),
             class_type* instance);
 
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             T decorator(T&&, const activation_context&));
 
     template <typename T>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             T decorator(T&&));
 
     template <typename T, typename class_type>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             T (class_type::*decorator)(T&&, const activation_context&),
             class_type* instance);
 
     template <typename T, typename class_type>
-    const decorator_definition& define_decorator(
+    decorator_definition& define_decorator(
             T (class_type::*interceptor)(T&&),
             class_type* instance);
 
+    /**
+     * @brief Defines a layered decorator for activated instances of T.
+     * @details
+     * A layered decorator is a type derived from T constructible from a reference to the decorated instance, which it
+     * doesn't own. Consecutive layered decorators of an activated instance are constructed in a single allocation and
+     * are destroyed together with the decorated instance. Layered decorators are applied after all other decorators of T.
+     * Decorated instances are released with a deleter of the layers, hence they have to be activated as shared instances
+     * or **unique_ref** - other activations of T, including factories and lazy dependencies, throw
+     * **std::logic_error**. For instance:
+     * @code
+     * struct logging_storage : storage
+     * {
+     *      explicit logging_storage(storage& undecorated);
+     *
+     *      void write(const record& record) override;
+     *
+     *      storage& undecorated_;
+     * };
+     *
+     * builder.define_decorator<storage, logging_storage>();
+     * builder.define_decorator<storage, metered_storage>();
+     * @endcode
+     *
+     * @tparam T Polymorphic type to decorate.
+     * @tparam decorator_type Decorator type derived from T, constructible from **T&**.
+     */
+    template <typename T, typename decorator_type>
+    decorator_definition& define_decorator();
+
     template <typename module_type>
     definition_builder& define_module(const module_type&& module);
 
@@ -812,14 +953,17 @@ private:
             typename identity<std::function<void(T*)>>::type&& deleter);
 
     template <typename T, typename... args_types>
-    const interceptor_definition& try_define_interceptor(
+    interceptor_definition& try_define_interceptor(
             typename identity<std::function<void(T&, const activation_context&, args_types...)>>::type&& interceptor);
 
     template <typename T>
-    const decorator_definition& try_define_decorator(
+    decorator_definition& try_define_decorator(
             typename identity<std::function<T*(T*, const activation_context&)>>::type&& decorator,
             typename identity<std::function<void(T*)>>::type&& deleter);
 
+    template <typename T>
+    decorator_definition& try_define_decorator(decorator_definition&& decorator);
+
     definition::map_type definitions_;
     interceptor_definition::map_type interceptors_;
     decorator_definition::map_type decorators_;
@@ -2,6 +2,9 @@
 
 #include "definition_builder.hpp"
 
+#include <di/tools/downcast.hpp>
+
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
@@ -38,6 +41,10 @@ inline const std::string& definition_builder::registration<T, args_types...>::id
  * @paragraph
  * This method will be only unfolded through SFINE for base types for T.
  *
+ * @paragraph
+ * Base definition invokes the creator of the original definition directly and converts created instance with an
+ * implicit upcast. Its deleter casts the instance back to T statically, unless D is a virtual base of T.
+ *
  * @tparam T A type which is a subject of the initial registration.
  * @tparam args_types List of argument types required by the base registration.
  * @tparam D A base type of T for which the base registration will be extended.
@@ -50,21 +57,20 @@ inline typename std::enable_if_t<std::is_base_of<D, T>::value, definition_builde
 {
     return builder_.try_define<D, args_types...>(
             id_,
-            [&definition = definition_](const activation_context& context, args_types... args) -> D*
+            // creator is held by the original definition, which isn't relocated when definitions are moved into activator
+            [&creator = definition_.template creator<T, args_types...>()](
+                    const activation_context& context,
+                    args_types... args) -> D*
             {
-                // it's save to keep the reference, but how about move into activator?
-                // https://stackoverflow.com/questions/11337494/c-stl-unordered-map-implementation-reference-validity
-                auto& creator = definition.template creator<T, args_types...>();
-
-                auto instance = creator(context, args...);
-                return dynamic_cast<D*>(instance);
+                return creator(context, args...);
             },
-            [&definition = definition_](D* pointer)
+            [deleter = definition_.template deleter<T>()](D* pointer)
             {
-                auto& deleter = definition.template deleter<T>();
-
+                auto instance = tools::downcast<T>(pointer);
                 if (deleter)
-                    deleter(reinterpret_cast<T*>(pointer));
+                    deleter(instance);
+                else
+                    delete instance;
             });
 }
 
@@ -72,6 +78,10 @@ inline typename std::enable_if_t<std::is_base_of<D, T>::value, definition_builde
  * @brief Registers a definition of wrapping type for the current registration output.
  * @details
  * This method registers a wrapper type constructable by moving a rvalue of type T as the only argument of type D constructor.
+ * The wrapper creates T within the activation context of the wrapper, through the binding of the original definition
+ * resolved once when the activator binds it, and constructs D from the created instance. T registered with a factory
+ * returning it by value is created on the stack, unless it's decorated with pointer decorators. The wrapper is
+ * declared as depending on the original definition.
  *
  * @tparam T The base type registered with this registration.
  * @tparam args_types Registration arguments.
@@ -83,19 +93,24 @@ template <typename D>
 inline typename std::enable_if_t<!std::is_base_of<D, T>::value, definition_builder::registration<D, args_types...>>
         definition_builder::registration<T, args_types...>::as()
 {
-    return builder_.try_define<D, args_types...>(
+    using binding_type = definition::binding<T, args_types...>;
+
+    auto bound = std::make_shared<const binding_type*>(nullptr);
+    definition_.define_bound_handler([bound](const definition& source)
+    {
+        *bound = &source.template bound<T, args_types...>();
+    });
+
+    auto wrapper = builder_.try_define<D, args_types...>(
             id_,
-            [id = id_](const activation_context& context, args_types... args) -> D*
+            [bound](const activation_context& context, args_types... args) -> D*
             {
-                return new D(context.activate_raii<T, args_types...>(id, args...));
+                return context.activate_wrapped<D, T, args_types...>(**bound, args...);
             },
-            [&definition = definition_](D* pointer)
-            {
-                auto& deleter = definition.template deleter<T>();
+            {});
 
-                if (deleter)
-                    deleter(reinterpret_cast<T*>(pointer));
-            });
+    static_cast<definition&>(wrapper).define_dependency(definition::make_dependency<T, args_types...>(id_, false));
+    return wrapper;
 }
 
 template <typename T, typename... args_types>
@@ -120,6 +135,170 @@ inline definition_builder::registration<T, args_types...>&
     return *this;
 }
 
+/**
+ * @brief Declares a dependency of this definition, activated together with it.
+ * @details
+ * Declared dependencies are validated when the activator is constructed. Construction fails with a report listing
+ * all missing definitions, definitions registered with different arguments and cycles between definitions.
+ * For instance:
+ * @code
+ * builder.define_default<engine>([](const activation_context& context) -> engine
+ *         {
+ *             return engine(context.activate_default_unique<storage>());
+ *         })
+ *         .depends_on<storage>();
+ * @endcode
+ *
+ * @tparam D Type of the dependency.
+ * @tparam dependency_args_types Activation arguments of the dependency.
+ * @param id Identifier of the dependency definition.
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+template <typename D, typename... dependency_args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::depends_on(
+        const std::string& id)
+{
+    definition_.define_dependency(definition::make_dependency<D, dependency_args_types...>(id, false));
+    return *this;
+}
+
+/**
+ * @brief Declares a dependency of this definition activated later on, through a factory or a lazy dependency.
+ * @details
+ * The dependency has to be defined, but it doesn't take part in cycle detection.
+ *
+ * @tparam D Type of the dependency.
+ * @tparam dependency_args_types Activation arguments of the dependency.
+ * @param id Identifier of the dependency definition.
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+template <typename D, typename... dependency_args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::depends_lazily_on(
+        const std::string& id)
+{
+    definition_.define_dependency(definition::make_dependency<D, dependency_args_types...>(id, true));
+    return *this;
+}
+
+/**
+ * @brief Makes shared activations of this definition return a single instance.
+ * @details
+ * The instance is created on the first shared activation and reused afterwards. Unique and RAII activations aren't
+ * affected and keep creating new instances.
+ *
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::single_instance()
+{
+    definition_.template define_lifetime<T, args_types...>(
+            definition::lifetime_type<T, args_types...>(single_instance_lifetime<T, args_types...>()));
+    return *this;
+}
+
+/**
+ * @brief Makes shared activations of this definition return an instance cached per activation arguments.
+ * @details
+ * Instances are cached in a bounded LRU split into independently locked shards, see **memoized_lifetime**. Unique and
+ * RAII activations aren't affected. For instance:
+ * @code
+ * builder.define<instrument, std::string>(
+ *                 [](const std::string& symbol) -> instrument
+ *                 {
+ *                     return instrument(symbol);
+ *                 })
+ *         .memoized(4096u);
+ * @endcode
+ *
+ * @param capacity Maximum number of cached instances.
+ * @param shards_count Number of independently locked shards.
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::memoized(
+        size_t capacity,
+        size_t shards_count)
+{
+    definition_.template define_lifetime<T, args_types...>(
+            definition::lifetime_type<T, args_types...>(memoized_lifetime<T, args_types...>(capacity, shards_count)));
+    return *this;
+}
+
+/**
+ * @brief Makes shared activations of this definition return an instance for as long as it's referenced.
+ * @details
+ * An instance activated previously with equal activation arguments is returned while any caller holds it, a new one is
+ * created once all of them release it, see **weak_instance_lifetime**. Unique and RAII activations aren't affected.
+ *
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::weak_instance()
+{
+    definition_.template define_lifetime<T, args_types...>(
+            definition::lifetime_type<T, args_types...>(weak_instance_lifetime<T, args_types...>()));
+    return *this;
+}
+
+/**
+ * @brief Makes shared activations of this definition return an instance per CPU.
+ * @details
+ * Shards of this definition are registered as **per_cpu_shards<T>** under the same id, to be activated for
+ * aggregation. See **per_cpu_lifetime**.
+ *
+ * @param shards_count Number of shards, the number of hardware threads when 0.
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::per_cpu(
+        size_t shards_count)
+{
+    per_cpu_lifetime<T, args_types...> lifetime(shards_count);
+    builder_.try_define<per_cpu_shards<T>>(
+            id_,
+            [shards = lifetime.shards()](const activation_context& context) -> per_cpu_shards<T>*
+            {
+                return new per_cpu_shards<T>(shards);
+            },
+            {});
+
+    definition_.template define_lifetime<T, args_types...>(
+            definition::lifetime_type<T, args_types...>(std::move(lifetime)));
+    return *this;
+}
+
+/**
+ * @brief Makes this definition a single instance constructed when the activator is constructed.
+ * @details
+ * @paragraph
+ * All eager definitions are constructed in parallel while **instance_activator** is being constructed. An eager
+ * component depending on another single instance, activated with **activate_shared**, either constructs that
+ * dependency or waits until the thread already constructing it finishes. As a result dependency order is discovered
+ * from the factories themselves and start-up time is bounded by the longest dependency chain.
+ *
+ * @paragraph
+ * The constructed instance is returned by all shared activations of this definition.
+ *
+ * @return This registration.
+ */
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...>& definition_builder::registration<T, args_types...>::eager()
+{
+    static_assert(
+            sizeof...(args_types) == 0u,
+            "definitions with arguments can't be eager!");
+
+    single_instance();
+    definition_.define_initializer([id = id_](const instance_activator& activator)
+    {
+        activator.template activate_shared<T>(id);
+    });
+
+    return *this;
+}
+
 template <typename T, typename... args_types>
 inline definition_builder::registration<T, args_types...>::operator definition&()
 {
@@ -135,14 +314,18 @@ inline definition_builder::registration<T, args_types...> definition_builder::de
             std::is_move_constructible<T>::value,
             "T has to be movable!");
 
-    return try_define<T, args_types...>(
+    auto value_creator = std::make_shared<definition::value_creator_type<T, args_types...>>(std::move(factory));
+    auto registration = try_define<T, args_types...>(
             id,
-            [factory = std::move(factory)](const activation_context& context, args_types... args) -> T*
+            [value_creator](const activation_context& context, args_types... args) -> T*
             {
-                auto created = factory(context, args...);
+                auto created = (*value_creator)(context, args...);
                 return new T(std::move(created));
             },
             {});
+
+    static_cast<definition&>(registration).define_value_creator<T, args_types...>(std::move(value_creator));
+    return registration;
 }
 
 template <typename T, typename... args_types>
@@ -271,6 +454,61 @@ inline definition_builder::registration<T, args_types...> definition_builder::de
     return define<T, args_types...>(definition::default_id, std::move(factory));
 }
 
+template <typename T>
+inline definition_builder::registration<T> definition_builder::define_type(
+        const std::string& id)
+{
+    auto registration = try_define<T>(id, constructor_injection<T>(), {});
+
+    definition& definition = registration;
+    for (auto& dependency : constructor_injection<T>::dependencies())
+        definition.define_dependency(std::move(dependency));
+
+    return registration;
+}
+
+template <typename T>
+inline definition_builder::registration<T> definition_builder::define_type()
+{
+    return define_type<T>(definition::default_id);
+}
+
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...> definition_builder::define_async(
+        const std::string& id,
+        typename identity<std::function<std::future<T>(const activation_context&, args_types...)>>::type&& factory)
+{
+    return define<T, args_types...>(id, [factory = std::move(factory)](const activation_context& context, args_types... args) -> T
+    {
+        return context.wait(factory(context, args...));
+    });
+}
+
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...> definition_builder::define_async(
+        const std::string& id,
+        typename identity<std::function<std::future<T>(args_types...)>>::type&& factory)
+{
+    return define_async<T, args_types...>(id, [factory = std::move(factory)](const activation_context& context, args_types... args) -> std::future<T>
+    {
+        return factory(args...);
+    });
+}
+
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...> definition_builder::define_default_async(
+        typename identity<std::function<std::future<T>(const activation_context&, args_types...)>>::type&& factory)
+{
+    return define_async<T, args_types...>(definition::default_id, std::move(factory));
+}
+
+template <typename T, typename... args_types>
+inline definition_builder::registration<T, args_types...> definition_builder::define_default_async(
+        typename identity<std::function<std::future<T>(args_types...)>>::type&& factory)
+{
+    return define_async<T, args_types...>(definition::default_id, std::move(factory));
+}
+
 template <typename T, typename... args_types>
 inline definition_builder::registration<T, args_types...> definition_builder::define_factory(
         const std::string &id,
@@ -352,14 +590,14 @@ inline definition_builder::registration<T, args_types...> definition_builder::de
 }
 
 template <typename T, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         typename identity<std::function<void(T& activated, const activation_context&, args_types...)>>::type&& interceptor)
 {
     return try_define_interceptor<T, args_types...>(std::move(interceptor));
 }
 
 template <typename T, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         typename identity<std::function<void(const activation_context&, args_types...)>>::type&& interceptor)
 {
     return define_interceptor<T, args_types...>(
@@ -370,7 +608,7 @@ inline const interceptor_definition& definition_builder::define_interceptor(
 }
 
 template <typename T, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         typename identity<std::function<void(args_types...)>>::type&& interceptor)
 {
     return define_interceptor<T, args_types...>(
@@ -381,7 +619,7 @@ inline const interceptor_definition& definition_builder::define_interceptor(
 }
 
 template <typename T, typename class_type, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         void (class_type::*interceptor)(T&, const activation_context&, args_types...),
         class_type* instance)
 {
@@ -393,7 +631,7 @@ inline const interceptor_definition& definition_builder::define_interceptor(
 };
 
 template <typename T, typename class_type, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         void (class_type::*interceptor)(T&, args_types...),
         class_type* instance)
 {
@@ -405,7 +643,7 @@ inline const interceptor_definition& definition_builder::define_interceptor(
 };
 
 template <typename T, typename class_type, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         void (class_type::*interceptor)(const activation_context&, args_types...),
         class_type* instance)
 {
@@ -417,7 +655,7 @@ inline const interceptor_definition& definition_builder::define_interceptor(
 };
 
 template <typename T, typename class_type, typename... args_types>
-inline const interceptor_definition& definition_builder::define_interceptor(
+inline interceptor_definition& definition_builder::define_interceptor(
         void (class_type::*interceptor)(args_types...),
         class_type* instance)
 {
@@ -428,8 +666,20 @@ inline const interceptor_definition& definition_builder::define_interceptor(
             });
 };
 
+template <typename T, typename... args_types>
+inline interceptor_definition& definition_builder::define_async_interceptor(
+        async_dispatcher::handler_type&& interceptor)
+{
+    auto definition_id = interceptor_definition::make_id<T, args_types...>();
+    auto emplace_result = interceptors_.emplace(
+            definition_id,
+            interceptor_definition::make_async(std::move(interceptor)));
+
+    return (*emplace_result).second;
+}
+
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         typename identity<std::function<T*(T* activated, const activation_context&)>>::type&& decorator,
         typename identity<std::function<void(T*)>>::type&& deleter)
 {
@@ -439,7 +689,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 }
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         typename identity<std::function<T*(T* activated)>>::type&& decorator,
         typename identity<std::function<void(T*)>>::type&& deleter)
 {
@@ -452,7 +702,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 }
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         typename identity<std::function<
                 std::unique_ptr<T>(std::unique_ptr<T>&& activated, const activation_context&)>>::type&& decorator)
 {
@@ -466,7 +716,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 }
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         typename identity<std::function<
                 std::unique_ptr<T>(std::unique_ptr<T>&& activated)>>::type&& decorator)
 {
@@ -478,23 +728,14 @@ inline const decorator_definition& definition_builder::define_decorator(
 }
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         typename identity<std::function<T(T&& activated, const activation_context&)>>::type&& decorator)
 {
-    return try_define_decorator<T>(
-            [decorator](T* instance, const activation_context& context) -> T*
-            {
-                auto decorated = decorator(std::move(*instance), context);
-                return new T(std::move(decorated));
-            },
-            [](T* pointer)
-            {
-                delete pointer;
-            });
+    return try_define_decorator<T>(decorator_definition::make_value<T>(std::move(decorator)));
 }
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         typename identity<std::function<T(T&& activated)>>::type&& decorator)
 {
     return define_decorator<T>(
@@ -505,7 +746,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 }
 
 template <typename T, typename class_type>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         std::unique_ptr<T> (class_type::*decorator)(std::unique_ptr<T>&&, const activation_context&),
         class_type* instance)
 {
@@ -518,7 +759,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 };
 
 template <typename T, typename class_type>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         std::unique_ptr<T> (class_type::*decorator)(std::unique_ptr<T>&&),
         class_type* instance)
 {
@@ -530,7 +771,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 };
 
 template <typename T, typename class_type>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         T (class_type::*decorator)(T&&, const activation_context&),
         class_type* instance)
 {
@@ -542,7 +783,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 };
 
 template <typename T, typename class_type>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         T (class_type::*decorator)(T&&),
         class_type* instance)
 {
@@ -554,7 +795,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 };
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         T decorator(T&&, const activation_context&))
 {
     return define_decorator<T>(
@@ -565,7 +806,7 @@ inline const decorator_definition& definition_builder::define_decorator(
 };
 
 template <typename T>
-inline const decorator_definition& definition_builder::define_decorator(
+inline decorator_definition& definition_builder::define_decorator(
         T decorator(T&&))
 {
     return define_decorator<T>(
@@ -575,6 +816,12 @@ inline const decorator_definition& definition_builder::define_decorator(
             });
 };
 
+template <typename T, typename decorator_type>
+inline decorator_definition& definition_builder::define_decorator()
+{
+    return try_define_decorator<T>(decorator_definition::make_layer<T, decorator_type>());
+}
+
 template <typename module_type>
 inline definition_builder& definition_builder::define_module(const module_type&& module)
 {
@@ -609,7 +856,7 @@ inline definition_builder::registration<T, args_types...> definition_builder::tr
 }
 
 template <typename T, typename... args_types>
-inline const interceptor_definition& definition_builder::try_define_interceptor(
+inline interceptor_definition& definition_builder::try_define_interceptor(
         typename identity<std::function<void(T&, const activation_context&, args_types...)>>::type&& interceptor)
 {
     auto definition_id = interceptor_definition::make_id<T, args_types...>();
@@ -622,7 +869,7 @@ inline const interceptor_definition& definition_builder::try_define_interceptor(
 }
 
 template <typename T>
-inline const decorator_definition& definition_builder::try_define_decorator(
+inline decorator_definition& definition_builder::try_define_decorator(
         typename identity<std::function<T*(T*, const activation_context&)>>::type&& decorator,
         typename identity<std::function<void(T*)>>::type&& deleter)
 {
@@ -635,4 +882,13 @@ inline const decorator_definition& definition_builder::try_define_decorator(
     return (*emplace_result).second;
 }
 
+template <typename T>
+inline decorator_definition& definition_builder::try_define_decorator(decorator_definition&& decorator)
+{
+    auto decorator_id = decorator_definition::make_id<T>();
+    auto emplace_result = decorators_.emplace(decorator_id, std::move(decorator));
+
+    return (*emplace_result).second;
+}
+
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "activator_handle.hpp"
+#include "annotations_map.hpp"
+
+#include <memory>
+
+
+namespace di {
+
+template <typename signature_type>
+class factory;
+
+/**
+ * @brief A typed factory of T bound to a resolved definition.
+ * @details
+ * A factory can be injected into a component which needs to create instances of its dependency at a later point,
+ * without holding on to an **activation_context** and without resolving the definition on each activation.
+ * For instance:
+ * @code
+ * definition_builder builder;
+ * builder.define_default<worker, int>([](int shard) -> worker
+ * {
+ *      return { shard };
+ * });
+ * builder.define_default<engine>([](const activation_context& context) -> engine
+ * {
+ *      return { context.activate_default_factory<worker, int>() };
+ * });
+ *
+ * [...]
+ *
+ * engine::engine(factory<worker(int)>&& worker_factory)
+ * {
+ *      for (auto shard = 0; shard < shards_count; shard++)
+ *          workers_.push_back(worker_factory(shard));
+ * }
+ * @endcode
+ *
+ * Each activation starts a new root activation context. Annotations of the context through which the factory has been
+ * obtained aren't carried over. A factory is valid for as long as the activator which created it is alive.
+ *
+ * @tparam T Activated type.
+ * @tparam args_types Activation argument types.
+ */
+template <typename T, typename... args_types>
+class factory<T(args_types...)>
+{
+public:
+    using result_type = std::unique_ptr<T>;
+
+    explicit factory(const activator_handle<T, args_types...>& handle);
+
+    /**
+     * @brief Default copy constructable.
+     */
+    factory(const factory& other) = default;
+    /**
+     * @brief Default move constructable.
+     */
+    factory(factory&& other) = default;
+    /**
+     * @brief Default copy assignable.
+     */
+    factory& operator=(const factory& other) = default;
+    /**
+     * @brief Default move assignable.
+     */
+    factory& operator=(factory&& other) = default;
+
+    std::unique_ptr<T> operator()(args_types... args) const;
+
+    std::unique_ptr<T> activate_unique(args_types... args) const;
+
+    std::shared_ptr<T> activate_shared(args_types... args) const;
+
+    T activate_raii(args_types... args) const;
+
+    std::unique_ptr<T> activate_unique(annotations_map&& annotations, args_types... args) const;
+
+    std::shared_ptr<T> activate_shared(annotations_map&& annotations, args_types... args) const;
+
+    T activate_raii(annotations_map&& annotations, args_types... args) const;
+
+private:
+    activator_handle<T, args_types...> handle_;
+
+};
+
+}
+
+#include "factory.ipp"
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "factory.hpp"
+
+
+namespace di {
+
+template <typename T, typename... args_types>
+inline factory<T(args_types...)>::factory(const activator_handle<T, args_types...>& handle)
+    : handle_(handle)
+{
+
+}
+
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> factory<T(args_types...)>::operator()(args_types... args) const
+{
+    return handle_.activate_unique(args...);
+}
+
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> factory<T(args_types...)>::activate_unique(args_types... args) const
+{
+    return handle_.activate_unique(args...);
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> factory<T(args_types...)>::activate_shared(args_types... args) const
+{
+    return handle_.activate_shared(args...);
+}
+
+template <typename T, typename... args_types>
+inline T factory<T(args_types...)>::activate_raii(args_types... args) const
+{
+    return handle_.activate_raii(args...);
+}
+
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> factory<T(args_types...)>::activate_unique(
+        annotations_map&& annotations,
+        args_types... args) const
+{
+    return handle_.activate_unique(std::move(annotations), args...);
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> factory<T(args_types...)>::activate_shared(
+        annotations_map&& annotations,
+        args_types... args) const
+{
+    return handle_.activate_shared(std::move(annotations), args...);
+}
+
+template <typename T, typename... args_types>
+inline T factory<T(args_types...)>::activate_raii(
+        annotations_map&& annotations,
+        args_types... args) const
+{
+    return handle_.activate_raii(std::move(annotations), args...);
+}
+
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <di/tools/traits/constructor_traits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace di {
+
+/**
+ * @brief Binds an interface to its implementation within a compile time **injector**.
+ *
+ * @tparam interface_type Type requested by dependent components.
+ * @tparam implementation_type Type constructed when **interface_type** is requested.
+ */
+template <typename interface_type, typename implementation_type = interface_type>
+struct binding
+{
+    static_assert(
+            std::is_base_of<interface_type, implementation_type>::value ||
+            std::is_same<interface_type, implementation_type>::value,
+            "implementation_type has to derive from interface_type!");
+
+    using interface = interface_type;
+    using implementation = implementation_type;
+};
+
+/**
+ * @brief Groups bindings of a compile time **injector**, in the same way a module groups runtime definitions.
+ *
+ * @tparam binding_types Bindings or nested modules.
+ */
+template <typename... binding_types>
+struct module
+{
+};
+
+/**
+ * @brief Finds implementation bound to T within bindings and modules. T itself, when no binding exists.
+ */
+template <typename T, typename... binding_types>
+struct implementation_of
+{
+    using implementation = T;
+};
+
+template <typename T, typename interface_type, typename implementation_type, typename... binding_types>
+struct implementation_of<T, binding<interface_type, implementation_type>, binding_types...>
+{
+    using implementation = typename std::conditional_t<
+            std::is_same<T, interface_type>::value,
+            binding<interface_type, implementation_type>,
+            implementation_of<T, binding_types...>>::implementation;
+};
+
+template <typename T, typename... module_binding_types, typename... binding_types>
+struct implementation_of<T, module<module_binding_types...>, binding_types...>
+    : implementation_of<T, module_binding_types..., binding_types...>
+{
+};
+
+/**
+ * @brief A compile time dependency injector.
+ * @details
+ * An alternative to **definition_builder** and **instance_activator** for latency critical paths. Bindings are declared
+ * as types and the graph is resolved by the compiler, activation compiles down to direct constructor calls - there is
+ * no hashing, no type erasure and no heap allocation unless a dependency is requested through a managed pointer.
+ *
+ * Dependencies are injected through constructors. The constructor with the greatest number of parameters which can be
+ * unambiguously resolved is used; aggregates are initialised member by member. Only class types are injected, members
+ * of other types keep their default initialisation. Each parameter can be:
+ * - a value or a const reference (to a temporary living until the constructor returns),
+ * - **std::unique_ptr** of an interface,
+ * - **std::shared_ptr** of an interface.
+ *
+ * For instance:
+ * @code
+ * struct storage_interface { virtual ~storage_interface() = default; };
+ * struct file_storage : storage_interface { };
+ *
+ * struct engine
+ * {
+ *      engine(clock clock, std::unique_ptr<storage_interface> storage);
+ * };
+ *
+ * using storage_module = module<binding<storage_interface, file_storage>>;
+ *
+ * injector<storage_module> injector;
+ * auto instance = injector.create<engine>();
+ * @endcode
+ *
+ * @tparam binding_types Bindings or modules.
+ */
+template <typename... binding_types>
+class injector final
+{
+public:
+    /**
+     * @brief A constructor argument of T, convertible to any class type dependency.
+     *
+     * @tparam T Constructed type, excluded from conversions.
+     */
+    template <typename T>
+    class argument
+    {
+    public:
+        explicit constexpr argument(const injector& injector);
+
+        template <
+                typename U,
+                typename = std::enable_if_t<
+                        std::is_class<std::decay_t<U>>::value && !std::is_same<std::decay_t<U>, T>::value>>
+        operator U() const;
+
+    private:
+        const injector& injector_;
+
+    };
+
+    /**
+     * @brief Default constructable.
+     */
+    constexpr injector() = default;
+
+    /**
+     * @brief Creates T with all its dependencies.
+     * @tparam T Type to create, a value, **std::unique_ptr** or **std::shared_ptr**.
+     * @return Created instance.
+     */
+    template <typename T>
+    T create() const;
+
+private:
+    template <typename T>
+    struct tag
+    {
+    };
+
+    template <typename T>
+    using traits = tools::constructor_traits<T, argument<T>>;
+
+    template <typename T>
+    T resolve(tag<T>) const;
+
+    template <typename T>
+    std::unique_ptr<T> resolve(tag<std::unique_ptr<T>>) const;
+
+    template <typename T>
+    std::shared_ptr<T> resolve(tag<std::shared_ptr<T>>) const;
+
+    template <typename T, size_t index>
+    argument<T> argument_at() const;
+
+    template <typename T, size_t... indexes>
+    T construct(std::index_sequence<indexes...>, std::false_type braced) const;
+
+    template <typename T, size_t... indexes>
+    T construct(std::index_sequence<indexes...>, std::true_type braced) const;
+
+    template <typename T, size_t... indexes>
+    T* allocate(std::index_sequence<indexes...>, std::false_type braced) const;
+
+    template <typename T, size_t... indexes>
+    T* allocate(std::index_sequence<indexes...>, std::true_type braced) const;
+
+};
+
+}
+
+#include "injector.ipp"
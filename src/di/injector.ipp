@@ -0,0 +1,107 @@
+#pragma once
+
+#include "injector.hpp"
+
+
+namespace di {
+
+template <typename... binding_types>
+template <typename T>
+inline constexpr injector<binding_types...>::argument<T>::argument(const injector& injector)
+    : injector_(injector)
+{
+
+}
+
+template <typename... binding_types>
+template <typename T>
+template <typename U, typename>
+inline injector<binding_types...>::argument<T>::operator U() const
+{
+    return injector_.template create<U>();
+}
+
+template <typename... binding_types>
+template <typename T>
+inline T injector<binding_types...>::create() const
+{
+    return resolve(tag<T>());
+}
+
+template <typename... binding_types>
+template <typename T>
+inline T injector<binding_types...>::resolve(tag<T>) const
+{
+    static_assert(
+            traits<T>::constructible,
+            "T can't be constructed from its dependencies!");
+
+    return construct<T>(
+            typename traits<T>::indexes(),
+            std::integral_constant<bool, traits<T>::braced>());
+}
+
+template <typename... binding_types>
+template <typename T>
+inline std::unique_ptr<T> injector<binding_types...>::resolve(tag<std::unique_ptr<T>>) const
+{
+    using implementation_type = typename implementation_of<T, binding_types...>::implementation;
+    static_assert(
+            traits<implementation_type>::constructible,
+            "Implementation of T can't be constructed from its dependencies!");
+
+    return std::unique_ptr<T>(allocate<implementation_type>(
+            typename traits<implementation_type>::indexes(),
+            std::integral_constant<bool, traits<implementation_type>::braced>()));
+}
+
+template <typename... binding_types>
+template <typename T>
+inline std::shared_ptr<T> injector<binding_types...>::resolve(tag<std::shared_ptr<T>>) const
+{
+    using implementation_type = typename implementation_of<T, binding_types...>::implementation;
+    static_assert(
+            traits<implementation_type>::constructible,
+            "Implementation of T can't be constructed from its dependencies!");
+
+    return std::shared_ptr<T>(allocate<implementation_type>(
+            typename traits<implementation_type>::indexes(),
+            std::integral_constant<bool, traits<implementation_type>::braced>()));
+}
+
+template <typename... binding_types>
+template <typename T, size_t index>
+inline typename injector<binding_types...>::template argument<T> injector<binding_types...>::argument_at() const
+{
+    return argument<T>(*this);
+}
+
+template <typename... binding_types>
+template <typename T, size_t... indexes>
+inline T injector<binding_types...>::construct(std::index_sequence<indexes...>, std::false_type) const
+{
+    return T(argument_at<T, indexes>()...);
+}
+
+template <typename... binding_types>
+template <typename T, size_t... indexes>
+inline T injector<binding_types...>::construct(std::index_sequence<indexes...>, std::true_type) const
+{
+    return T { argument_at<T, indexes>()... };
+}
+
+template <typename... binding_types>
+template <typename T, size_t... indexes>
+inline T* injector<binding_types...>::allocate(std::index_sequence<indexes...>, std::false_type) const
+{
+    return new T(argument_at<T, indexes>()...);
+}
+
+template <typename... binding_types>
+template <typename T, size_t... indexes>
+inline T* injector<binding_types...>::allocate(std::index_sequence<indexes...>, std::true_type) const
+{
+    return new T { argument_at<T, indexes>()... };
+}
+
+}
@@ -0,0 +1,432 @@
+#include "instance_activator.hpp"
+
+#include <di/tools/cxxabi_utils.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace std;
+
+
+namespace di {
+
+namespace {
+
+using node_type = definition::map_type::value_type;
+
+string describe(const node_type& node)
+{
+    stringstream description;
+    description << tools::demangle(node.second.type().name()) << " '" << node.first.first << "'";
+
+    return description.str();
+}
+
+string describe(const definition::dependency& dependency)
+{
+    stringstream description;
+    description << dependency.description << " '" << dependency.id.first << "'";
+
+    return description.str();
+}
+
+string describe_arguments(const definition& definition)
+{
+    stringstream description;
+
+    auto& arguments = definition.arguments();
+    for (auto i = 0u; i < arguments.size(); i++)
+    {
+        if (i > 0u)
+            description << ", ";
+        description << tools::demangle(arguments[i].name());
+    }
+
+    return description.str();
+}
+
+string escape(const string& value)
+{
+    static const char* hex_digits = "0123456789abcdef";
+
+    string escaped;
+    for (auto character : value)
+    {
+        auto code = static_cast<unsigned char>(character);
+        if (character == '"' || character == '\\')
+        {
+            escaped.push_back('\\');
+            escaped.push_back(character);
+        }
+        else if (character == '\n')
+            escaped.append("\\n");
+        else if (character == '\t')
+            escaped.append("\\t");
+        else if (character == '\r')
+            escaped.append("\\r");
+        else if (code < 0x20u)
+        {
+            // valid within both JSON strings and DOT labels
+            escaped.append("\\u00");
+            escaped.push_back(hex_digits[code >> 4u]);
+            escaped.push_back(hex_digits[code & 0x0fu]);
+        }
+        else
+            escaped.push_back(character);
+    }
+
+    return escaped;
+}
+
+struct graph_edge
+{
+    size_t from;
+    size_t to;
+    bool deferred;
+};
+
+void write_dot(ostream& os, const vector<const node_type*>& nodes, const vector<graph_edge>& edges)
+{
+    using namespace std::chrono;
+
+    os << "digraph definitions {" << endl;
+    for (auto i = 0u; i < nodes.size(); i++)
+    {
+        auto& id = nodes[i]->first.first;
+        auto& definition = nodes[i]->second;
+        auto& statistics = *definition.statistics();
+
+        os << "  n" << i << " [shape=box, label=\"";
+        os << escape(tools::demangle(definition.type().name())) << "(" << escape(describe_arguments(definition)) << ")";
+        os << "\\nid: '" << escape(id) << "'";
+        os << "\\ninterceptors: " << definition.interceptors_count() << ", decorators: " << definition.decorators_count();
+        os << "\\nlifetime: " << (definition.has_lifetime() ? "managed" : "transient");
+        os << (definition.initializer() ? ", eager" : "");
+        os << "\\nactivations: " << statistics.activations();
+        os << ", mean: " << duration_cast<microseconds>(statistics.mean_creation_time()).count() << " us";
+        os << "\"];" << endl;
+    }
+
+    for (auto& edge : edges)
+        os << "  n" << edge.from << " -> n" << edge.to << (edge.deferred ? " [style=dashed]" : "") << ";" << endl;
+
+    os << "}" << endl;
+}
+
+void write_json(ostream& os, const vector<const node_type*>& nodes, const vector<graph_edge>& edges)
+{
+    os << "{\"definitions\":[";
+    for (auto i = 0u; i < nodes.size(); i++)
+    {
+        auto& id = nodes[i]->first.first;
+        auto& definition = nodes[i]->second;
+        auto& statistics = *definition.statistics();
+
+        os << (i > 0u ? "," : "") << "{\"index\":" << i;
+        os << ",\"id\":\"" << escape(id) << "\"";
+        os << ",\"type\":\"" << escape(tools::demangle(definition.type().name())) << "\"";
+        os << ",\"arguments\":[";
+
+        auto& arguments = definition.arguments();
+        for (auto j = 0u; j < arguments.size(); j++)
+            os << (j > 0u ? "," : "") << "\"" << escape(tools::demangle(arguments[j].name())) << "\"";
+
+        os << "],\"interceptors\":" << definition.interceptors_count();
+        os << ",\"decorators\":" << definition.decorators_count();
+        os << ",\"lifetime\":\"" << (definition.has_lifetime() ? "managed" : "transient") << "\"";
+        os << ",\"eager\":" << (definition.initializer() ? "true" : "false");
+        os << ",\"activations\":" << statistics.activations();
+        os << ",\"mean_creation_time_ns\":" << statistics.mean_creation_time().count();
+        os << "}";
+    }
+
+    os << "],\"dependencies\":[";
+    for (auto i = 0u; i < edges.size(); i++)
+    {
+        os << (i > 0u ? "," : "") << "{\"from\":" << edges[i].from << ",\"to\":" << edges[i].to;
+        os << ",\"deferred\":" << (edges[i].deferred ? "true" : "false") << "}";
+    }
+    os << "]}" << endl;
+}
+
+struct tracked_definition
+{
+    string description;
+    shared_ptr<activation_statistics> statistics;
+};
+
+vector<tracked_definition> track(const definition::map_type& definitions)
+{
+    vector<tracked_definition> tracked;
+    tracked.reserve(definitions.size());
+
+    for (auto& node : definitions)
+        tracked.push_back({ describe(node), node.second.statistics() });
+
+    return tracked;
+}
+
+void write_live_instances(ostream& os, const vector<tracked_definition>& tracked)
+{
+    uint64_t total_instances = 0u;
+    uint64_t total_bytes = 0u;
+
+    os << "Live instances:" << endl;
+    for (auto& definition : tracked)
+    {
+        auto instances = definition.statistics->live_instances();
+        if (instances == 0u)
+            continue;
+
+        auto bytes = definition.statistics->live_bytes();
+        os << "  " << definition.description << ": " << instances << " instances, " << bytes << " bytes" << endl;
+
+        total_instances += instances;
+        total_bytes += bytes;
+    }
+    os << "total: " << total_instances << " instances, " << total_bytes << " bytes" << endl;
+}
+
+enum class visit_state
+{
+    visiting,
+    visited
+};
+
+void find_cycles(
+        const definition::map_type& definitions,
+        const node_type& node,
+        unordered_map<const node_type*, visit_state>& states,
+        vector<const node_type*>& path,
+        stringstream& report)
+{
+    states[&node] = visit_state::visiting;
+    path.push_back(&node);
+
+    for (auto& dependency : node.second.dependencies())
+    {
+        if (dependency.deferred)
+            continue;
+
+        auto found = definitions.find(dependency.id);
+        if (found == definitions.end())
+            continue;
+
+        auto& next = *found;
+        auto state = states.find(&next);
+        if (state == states.end())
+        {
+            find_cycles(definitions, next, states, path, report);
+        }
+        else if (state->second == visit_state::visiting)
+        {
+            report << "  cycle: ";
+
+            auto cycle_start = find(path.begin(), path.end(), &next);
+            for (auto iter = cycle_start; iter != path.end(); ++iter)
+                report << describe(**iter) << " -> ";
+            report << describe(next) << endl;
+        }
+    }
+
+    path.pop_back();
+    states[&node] = visit_state::visited;
+}
+
+}
+
+instance_activator& instance_activator::operator=(instance_activator&& other)
+{
+    if (this == &other)
+        return *this;
+
+    // the dispatcher still delivers to interceptors of this activator, it has to be stopped before they are replaced
+    shutdown();
+
+    definitions_ = std::move(other.definitions_);
+    interceptors_ = std::move(other.interceptors_);
+    decorators_ = std::move(other.decorators_);
+    modules_ = std::move(other.modules_);
+    trace_enabled_ = other.trace_enabled_;
+    statistics_enabled_ = other.statistics_enabled_;
+    tracer_ = std::move(other.tracer_);
+    instrumented_ = other.instrumented_;
+    instance_tracking_enabled_ = other.instance_tracking_enabled_;
+    shutdown_report_ = other.shutdown_report_;
+    dispatcher_ = std::move(other.dispatcher_);
+
+    other.shutdown_report_ = nullptr;
+
+    return *this;
+}
+
+instance_activator::~instance_activator()
+{
+    shutdown();
+}
+
+void instance_activator::shutdown()
+{
+    dispatcher_.reset();
+
+    if (!shutdown_report_)
+        return;
+
+    auto tracked = track(definitions_);
+    definitions_.clear();
+
+    auto leaked = any_of(tracked.begin(), tracked.end(), [](const tracked_definition& definition)
+    {
+        return definition.statistics->live_instances() > 0u;
+    });
+
+    if (leaked)
+        write_live_instances(*shutdown_report_, tracked);
+}
+
+void instance_activator::flush_interceptors() const
+{
+    if (dispatcher_)
+        dispatcher_->flush();
+}
+
+uint64_t instance_activator::dropped_interceptions() const
+{
+    return dispatcher_ ? dispatcher_->dropped() : 0u;
+}
+
+void instance_activator::set_statistics_enabled(bool enabled)
+{
+    statistics_enabled_ = enabled;
+    instrumented_ = statistics_enabled_ || tracer_;
+}
+
+bool instance_activator::statistics_enabled() const
+{
+    return statistics_enabled_;
+}
+
+vector<activation_metrics> instance_activator::metrics() const
+{
+    vector<activation_metrics> metrics;
+    metrics.reserve(definitions_.size());
+
+    for (auto& node : definitions_)
+        metrics.push_back({ node.first.first, node.second.type(), node.second.statistics()->snapshot() });
+
+    return metrics;
+}
+
+void instance_activator::set_tracer(shared_ptr<activation_tracer> tracer)
+{
+    tracer_ = std::move(tracer);
+    instrumented_ = statistics_enabled_ || tracer_;
+}
+
+const shared_ptr<activation_tracer>& instance_activator::tracer() const
+{
+    return tracer_;
+}
+
+void instance_activator::set_instance_tracking_enabled(bool enabled, ostream* shutdown_report)
+{
+    instance_tracking_enabled_ = enabled;
+    shutdown_report_ = enabled ? shutdown_report : nullptr;
+}
+
+bool instance_activator::instance_tracking_enabled() const
+{
+    return instance_tracking_enabled_;
+}
+
+void instance_activator::report_live_instances(ostream& os) const
+{
+    write_live_instances(os, track(definitions_));
+}
+
+void instance_activator::export_graph(ostream& os, graph_format format) const
+{
+    unordered_map<const definition*, size_t> indexes;
+    vector<const node_type*> nodes;
+    for (auto& node : definitions_)
+    {
+        indexes[&node.second] = nodes.size();
+        nodes.push_back(&node);
+    }
+
+    vector<graph_edge> edges;
+    for (auto i = 0u; i < nodes.size(); i++)
+    {
+        auto& node_definition = nodes[i]->second;
+        for (auto& dependency : node_definition.dependencies())
+        {
+            auto found = definitions_.find(dependency.id);
+            if (found != definitions_.end())
+                edges.push_back({ i, indexes[&found->second], dependency.deferred });
+        }
+
+        for (auto dependency : node_definition.statistics()->dependencies())
+        {
+            auto to = indexes[dependency];
+            auto declared = find_if(edges.begin(), edges.end(), [i, to](const graph_edge& edge)
+            {
+                return edge.from == i && edge.to == to;
+            });
+
+            if (declared == edges.end())
+                edges.push_back({ i, to, false });
+        }
+    }
+
+    if (format == graph_format::dot)
+        write_dot(os, nodes, edges);
+    else
+        write_json(os, nodes, edges);
+}
+
+void instance_activator::validate() const
+{
+    stringstream report;
+
+    for (auto& node : definitions_)
+    {
+        for (auto& dependency : node.second.dependencies())
+        {
+            if (definitions_.find(dependency.id) != definitions_.end())
+                continue;
+
+            auto mismatched = find_if(definitions_.begin(), definitions_.end(), [&dependency](const node_type& other)
+            {
+                return other.first.first == dependency.id.first && other.second.type() == dependency.type;
+            });
+
+            if (mismatched != definitions_.end())
+                report << "  arguments mismatch: " << describe(node) << " requires " << describe(dependency) << endl;
+            else
+                report << "  missing: " << describe(node) << " requires " << describe(dependency) << endl;
+        }
+    }
+
+    unordered_map<const node_type*, visit_state> states;
+    vector<const node_type*> path;
+    for (auto& node : definitions_)
+    {
+        if (states.find(&node) == states.end())
+            find_cycles(definitions_, node, states, path, report);
+    }
+
+    auto problems = report.str();
+    if (!problems.empty())
+        throw invalid_argument("Invalid definitions:\n" + problems);
+}
+
+}
@@ -1,20 +1,36 @@
 #pragma once
 
+#include "activation_tracer.hpp"
+#include "async_dispatcher.hpp"
 #include "definition.hpp"
 #include "decorator_definition.hpp"
 #include "interceptor_definition.hpp"
+#include "ownership.hpp"
+#include "unique_ref.hpp"
 
 #include <functional>
+#include <future>
 #include <list>
+#include <ostream>
 #include <memory>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 namespace di {
 
+template <typename T, typename... args_types>
+class activator_handle;
+
+template <typename signature_type>
+class factory;
+
+template <typename T>
+class constructor_injection;
+
 /**
  * @brief A dependency injection activator.
  *
@@ -26,6 +42,15 @@ namespace di {
 class instance_activator final
 {
 public:
+    /**
+     * @brief Format of an exported definitions graph.
+     */
+    enum class graph_format
+    {
+        dot,
+        json
+    };
+
     template <typename builder_type>
     explicit instance_activator(builder_type&& builder, bool trace_enabled = false);
 
@@ -48,9 +73,113 @@ public:
     instance_activator& operator=(const instance_activator& other) = delete;
 
     /**
-     * @brief Default move assignable.
+     * @brief Move assignable.
+     * @details
+     * Asynchronous interceptors of this activator are flushed and the shutdown report, if requested, is written before
+     * definitions of the other activator replace these.
      */
-    instance_activator& operator=(instance_activator&& other) = default;
+    instance_activator& operator=(instance_activator&& other);
+
+    /**
+     * @brief Writes the shutdown report of live instances, if requested with **set_instance_tracking_enabled**.
+     */
+    ~instance_activator();
+
+    /**
+     * @brief Enables collection of activation statistics.
+     * @details
+     * When enabled, each activation records its count, failures, creation time, live instances and definitions
+     * activated from within it, in statistics of the activated definition. Should be set before activations start.
+     *
+     * @param enabled **true** to collect statistics.
+     */
+    void set_statistics_enabled(bool enabled);
+
+    bool statistics_enabled() const;
+
+    /**
+     * @brief Installs a tracer receiving begin and end events of all activations.
+     * @details
+     * Without a tracer and with statistics disabled, an activation pays for a single branch only. Should be set before
+     * activations start.
+     *
+     * @param tracer Tracer to install, **nullptr** to uninstall the current one.
+     */
+    void set_tracer(std::shared_ptr<activation_tracer> tracer);
+
+    const std::shared_ptr<activation_tracer>& tracer() const;
+
+    /**
+     * @brief Enables tracking of live instances.
+     * @details
+     * When enabled, each instance activated as shared or **unique_ref** is counted in statistics of its definition until
+     * destroyed, together with the size of its type. Instances activated as unique or RAII aren't counted, they are
+     * handed over without the registered deleter.
+     * Tracking is also enabled with statistics. Should be set before activations start.
+     *
+     * When a shutdown report stream is given, instances still alive once the activator releases its definitions (and
+     * instances retained by their lifetimes) are reported on destruction of this activator. For instance:
+     * @code
+     * instance_activator activator(std::move(builder));
+     * activator.set_instance_tracking_enabled(true, &std::cerr);
+     * @endcode
+     *
+     * @param enabled **true** to track live instances.
+     * @param shutdown_report Stream receiving the report on destruction, **nullptr** for no report.
+     */
+    void set_instance_tracking_enabled(bool enabled, std::ostream* shutdown_report = nullptr);
+
+    bool instance_tracking_enabled() const;
+
+    /**
+     * @brief Writes the number and size of live instances of each definition with any live instances.
+     * @param os Output stream.
+     */
+    void report_live_instances(std::ostream& os) const;
+
+    /**
+     * @brief Waits until asynchronous interceptors receive all activations completed before this call.
+     */
+    void flush_interceptors() const;
+
+    /**
+     * @brief Number of activations not delivered to asynchronous interceptors because their queue was full.
+     */
+    uint64_t dropped_interceptions() const;
+
+    /**
+     * @brief Takes a snapshot of statistics of all definitions.
+     * @details
+     * Statistics are collected only when enabled with **set_statistics_enabled**. Live instances are tracked for
+     * instances activated as shared or **unique_ref** while statistics or instance tracking are enabled. For instance:
+     * @code
+     * for (auto& metrics : activator.metrics())
+     *      if (metrics.statistics.activations > expected_activations)
+     *          report(metrics.id, metrics.type, metrics.statistics);
+     * @endcode
+     *
+     * @return Statistics of each definition, with its id and type.
+     */
+    std::vector<activation_metrics> metrics() const;
+
+    /**
+     * @brief Exports the graph of definitions.
+     * @details
+     * Each definition is described by its id, type, arguments, number of interceptors and decorators, lifetime and
+     * collected statistics - activation count and mean creation time. Edges are formed by declared dependencies
+     * (dashed when deferred) and dependencies observed while collecting statistics. For instance:
+     * @code
+     * activator.set_statistics_enabled(true);
+     * [...]
+     *
+     * std::ofstream file("graph.dot");
+     * activator.export_graph(file, instance_activator::graph_format::dot);
+     * @endcode
+     *
+     * @param os Output stream.
+     * @param format Graphviz DOT or JSON.
+     */
+    void export_graph(std::ostream& os, graph_format format) const;
 
     template <typename T, typename... args_types>
     std::unique_ptr<T> activate_unique(activation_context& context, args_types... args) const;
@@ -61,9 +190,43 @@ public:
     template <typename T, typename... args_types>
     T activate_raii(activation_context& context, args_types... args) const;
 
+    template <typename T, typename... args_types>
+    unique_ref<T> activate_unique_ref(activation_context& context, args_types... args) const;
+
     template <typename T, typename... args_types>
     bool can_activate(const std::string& id) const;
 
+    /**
+     * @brief Resolves a definition of T with given id and arguments once, for repeated activation.
+     * @details
+     * Returned handle references the definition, its interceptors and decorators directly. Activation through the
+     * handle bypasses id construction, hashing and lookup. For instance:
+     * @code
+     * instance_activator activator(std::move(builder));
+     * auto handle = activator.resolve<TestObject_1, string>(sample_id);
+     *
+     * for (auto& message : messages)
+     *      auto instance = handle.activate_unique(message);
+     * @endcode
+     * The handle remains valid as long as this activator is alive and isn't moved.
+     *
+     * @tparam T Type to resolve.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @return A handle bound to the resolved definition.
+     */
+    template <typename T, typename... args_types>
+    activator_handle<T, args_types...> resolve(const std::string& id) const;
+
+    template <typename T, typename... args_types>
+    activator_handle<T, args_types...> resolve_default() const;
+
+    template <typename T, typename... args_types>
+    factory<T(args_types...)> activate_factory(const std::string& id) const;
+
+    template <typename T, typename... args_types>
+    factory<T(args_types...)> activate_default_factory() const;
+
     template <typename T, typename... args_types>
     std::unique_ptr<T> activate_unique(const std::string& id, args_types... args) const;
 
@@ -73,6 +236,22 @@ public:
     template <typename T, typename... args_types>
     T activate_raii(const std::string& id, args_types... args) const;
 
+    /**
+     * @brief Activates a unique instance of T released with the deleter registered with its definition.
+     * @details
+     * Deleter of the last applied decorator or deleter given when T was defined is preserved, instances allocated by
+     * factories from pools, arenas or custom allocators are returned to them. The instance has to be released while
+     * this activator is alive.
+     *
+     * @tparam T Type to activate.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @param args Activation arguments.
+     * @return Activated instance.
+     */
+    template <typename T, typename... args_types>
+    unique_ref<T> activate_unique_ref(const std::string& id, args_types... args) const;
+
     template <typename T, typename... args_types>
     std::unique_ptr<T> activate_unique(
             const std::string& id,
@@ -91,6 +270,72 @@ public:
             annotations_map&& annotations,
             args_types... args) const;
 
+    /**
+     * @brief Activates a batch of instances of T with the same definition.
+     * @details
+     * The definition, its interceptors and decorators are resolved once for the whole batch and all instances are
+     * activated within a single activation context.
+     *
+     * @tparam T Type to activate.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @param count Number of instances to activate.
+     * @param args Activation arguments, passed to each activation.
+     * @return Activated instances.
+     */
+    template <typename T, typename... args_types>
+    std::vector<std::unique_ptr<T>> activate_many(
+            const std::string& id,
+            size_t count,
+            args_types... args) const;
+
+    /**
+     * @brief Activates a batch of instances of T with the same definition into a caller provided buffer.
+     * @details
+     * The definition, its interceptors and decorators are resolved once for the whole batch and all instances are
+     * activated within a single activation context.
+     *
+     * @tparam T Type to activate.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @param instances A buffer of at least **count** elements receiving activated instances.
+     * @param count Number of instances to activate.
+     * @param args Activation arguments, passed to each activation.
+     */
+    template <typename T, typename... args_types>
+    void activate_many(
+            const std::string& id,
+            std::unique_ptr<T>* instances,
+            size_t count,
+            args_types... args) const;
+
+    /**
+     * @brief Activates a unique instance of T asynchronously.
+     * @details
+     * The definition is resolved immediately, activation itself is executed on the shared thread pool. Dependencies
+     * activated asynchronously from within factories (see **activation_context::activate_async**) and asynchronous
+     * factories (see **definition_builder::define_async**) proceed concurrently. Returned future completes when the
+     * whole graph of T is activated. For instance:
+     * @code
+     * instance_activator activator(std::move(builder));
+     * auto pending = activator.activate_async<engine>("engine");
+     *
+     * [...]
+     *
+     * auto instance = pending.get();
+     * @endcode
+     *
+     * @tparam T Type to activate.
+     * @tparam args_types Activation argument types.
+     * @param id Definition identifier.
+     * @param args Activation arguments, captured by value.
+     * @return A future of the activated instance.
+     */
+    template <typename T, typename... args_types>
+    std::future<std::unique_ptr<T>> activate_async(
+            const std::string& id,
+            args_types... args) const;
+
     template <typename T, typename... args_types>
     bool can_activate_default() const;
 
@@ -103,6 +348,24 @@ public:
     template <typename T, typename... args_types>
     T activate_default_raii(args_types... args) const;
 
+    template <typename T, typename... args_types>
+    unique_ref<T> activate_default_unique_ref(args_types... args) const;
+
+    template <typename T, typename... args_types>
+    std::vector<std::unique_ptr<T>> activate_default_many(
+            size_t count,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    void activate_default_many(
+            std::unique_ptr<T>* instances,
+            size_t count,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    std::future<std::unique_ptr<T>> activate_default_async(
+            args_types... args) const;
+
     template <typename T, typename... args_types>
     std::unique_ptr<T> activate_default_unique(
             annotations_map&& annotations,
@@ -119,17 +382,179 @@ public:
             args_types... args) const;
 
 private:
+    friend activation_context;
+
+    template <typename T, typename... args_types>
+    friend class activator_handle;
+
+    template <typename T>
+    friend class constructor_injection;
+
+    template <typename T, typename... args_types>
+    const definition::map_type::value_type& find(const std::string& id) const;
+
+    template <typename T, typename... args_types>
+    activator_handle<T, args_types...> resolve(const definition::binding<T, args_types...>& binding) const;
+
+    /**
+     * @brief Validates dependencies declared by definitions.
+     * @throws std::invalid_argument Reporting all missing dependencies, dependencies with mismatched arguments and
+     * cycles.
+     */
+    void validate() const;
+
+    /**
+     * @brief Stops the asynchronous dispatcher and writes the shutdown report, if requested.
+     */
+    void shutdown();
+
+    template <typename T, typename... args_types>
+    std::unique_ptr<T> activate_unique(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    std::shared_ptr<T> activate_shared(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    T activate_raii(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    unique_ref<T> activate_unique_ref(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    /**
+     * @brief Creates T within the context of a wrapper D and constructs D from the created instance.
+     * @details
+     * T is created through the given binding, without looking it up by id, and intercepted and decorated within the
+     * context of the wrapper. When T has a value creator and only value decorators, it's created on the stack and moved
+     * into D. Otherwise the allocated instance is moved into D and released.
+     *
+     * @throws std::logic_error If T is decorated with layers.
+     */
+    template <typename D, typename T, typename... args_types>
+    D* activate_wrapped(
+            const definition::binding<T, args_types...>& binding,
+            const activation_context& context,
+            args_types... args) const;
+
+    template <typename D, typename T, typename... args_types>
+    D* activate_wrapped(
+            const definition::binding<T, args_types...>& binding,
+            const activation_context& context,
+            std::true_type movable,
+            args_types... args) const;
+
+    template <typename D, typename T, typename... args_types>
+    D* activate_wrapped(
+            const definition::binding<T, args_types...>& binding,
+            const activation_context& context,
+            std::false_type movable,
+            args_types... args) const;
+
+    /**
+     * @brief Activation pipeline shared by all activation modes.
+     * @details
+     * Allocates, intercepts and decorates an instance within the given context and hands it over according to the
+     * ownership policy. Instances of managed policies are created through the lifetime of the definition, if any.
+     *
+     * @tparam ownership_type One of **value_ownership**, **unique_ownership**, **shared_ownership** or
+     * **borrowed_ownership**.
+     * @throws std::logic_error If T is decorated with layers and the policy can't release them.
+     */
+    template <typename ownership_type, typename T, typename... args_types>
+    typename ownership_type::template instance_type<T> activate_owned(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    static bool layered(const definition::binding<T, args_types...>& binding);
+
+    template <typename T, typename... args_types, typename create_type>
+    auto manage(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            create_type& create,
+            std::true_type managed,
+            args_types... args) const -> decltype(create());
+
+    template <typename T, typename... args_types, typename create_type>
+    auto manage(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            create_type& create,
+            std::false_type managed,
+            args_types... args) const -> decltype(create());
+
     template <typename T, typename... args_types>
     std::pair<T*, const std::function<void(T*)>&> allocate(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    std::pair<T*, const std::function<void(T*)>&> instrument(
+            const definition::binding<T, args_types...>& binding,
+            activation_context& context,
+            args_types... args) const;
+
+    template <typename T, typename... args_types>
+    std::pair<T*, const std::function<void(T*)>&> construct(
+            const definition::binding<T, args_types...>& binding,
             activation_context& context,
             args_types... args) const;
 
+    template <typename T, typename... args_types>
+    std::pair<T*, const std::function<void(T*)>&> decorate(
+            const definition::binding<T, args_types...>& binding,
+            T* instance,
+            const activation_context& context,
+            args_types... args) const;
+
+    /**
+     * @brief Applies a value decorator in place of the decorated instance.
+     * @details
+     * The decorated value is constructed in storage of the decorated instance when T is nothrow move constructible and
+     * the instance is of exactly T, otherwise it's allocated and the decorated instance is released.
+     */
+    template <typename T>
+    static T* decorate_value(
+            const decorator_definition& decorator,
+            T* instance,
+            const std::function<void(T*)>*& deleter,
+            const activation_context& context,
+            std::true_type movable);
+
+    template <typename T>
+    static T* decorate_value(
+            const decorator_definition& decorator,
+            T* instance,
+            const std::function<void(T*)>*& deleter,
+            const activation_context& context,
+            std::false_type movable);
+
     definition::map_type definitions_;
     interceptor_definition::map_type interceptors_;
     decorator_definition::map_type decorators_;
     std::list<boost::any> modules_;
 
     bool trace_enabled_;
+    bool statistics_enabled_;
+    std::shared_ptr<activation_tracer> tracer_;
+    bool instrumented_;
+    bool instance_tracking_enabled_;
+    std::ostream* shutdown_report_;
+    std::unique_ptr<async_dispatcher> dispatcher_;
 
 };
 
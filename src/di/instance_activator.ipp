@@ -2,15 +2,27 @@
 
 #include "instance_activator.hpp"
 #include "activation_context.hpp"
+#include "activator_handle.hpp"
+#include "factory.hpp"
 
 #include <di/tools/cxxabi_utils.hpp>
+#include <di/tools/thread_pool.hpp>
 #include <di/tools/traits/veriadic_traits.hpp>
 
+#include <boost/optional.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 
 namespace di {
@@ -24,9 +36,61 @@ inline instance_activator::instance_activator(
         interceptors_(std::move(builder.interceptors_)),
         decorators_(std::move(builder.decorators_)),
         modules_(std::move(builder.modules_)),
-        trace_enabled_(trace_enabled)
+        trace_enabled_(trace_enabled),
+        statistics_enabled_(false),
+        instrumented_(false),
+        instance_tracking_enabled_(false),
+        shutdown_report_(nullptr),
+        dispatcher_()
 {
+    for (auto& interceptor : interceptors_)
+    {
+        if (interceptor.second.asynchronous())
+        {
+            dispatcher_.reset(new async_dispatcher());
+            break;
+        }
+    }
+
+    std::vector<const definition::initializer_type*> initializers;
+    for (auto& definition : definitions_)
+    {
+        definition.second.bind(definition.first.first, interceptors_, decorators_);
+        if (definition.second.initializer())
+            initializers.push_back(&definition.second.initializer());
+    }
+
+    validate();
+
+    if (initializers.empty())
+        return;
+
+    auto concurrency = std::min<size_t>(initializers.size(), std::thread::hardware_concurrency());
+    tools::thread_pool pool(concurrency);
+
+    std::vector<std::future<void>> initialized;
+    for (auto initializer : initializers)
+        initialized.push_back(pool.submit([this, initializer]()
+        {
+            (*initializer)(*this);
+        }));
+
+    std::exception_ptr failure;
+    for (auto& future : initialized)
+    {
+        try
+        {
+            pool.wait(future);
+        }
+        catch (...)
+        {
+            if (!failure)
+                failure = std::current_exception();
+        }
+    }
 
+    if (failure)
+        std::rethrow_exception(failure);
 }
 
 template <typename T, typename... args_types>
@@ -34,8 +98,8 @@ inline std::unique_ptr<T> instance_activator::activate_unique(
         activation_context& context,
         args_types... args) const
 {
-    auto allocated = allocate<T, args_types...>(context, args...);
-    return std::unique_ptr<T>(allocated.first);
+    auto& binding = find<T, args_types...>(context.id()).second.template bound<T, args_types...>();
+    return activate_unique<T, args_types...>(binding, context, args...);
 }
 
 template <typename T, typename... args_types>
@@ -43,8 +107,8 @@ inline std::shared_ptr<T> instance_activator::activate_shared(
         activation_context& context,
         args_types... args) const
 {
-    auto allocated = allocate<T, args_types...>(context, args...);
-    return std::shared_ptr<T>(allocated.first);
+    auto& binding = find<T, args_types...>(context.id()).second.template bound<T, args_types...>();
+    return activate_shared<T, args_types...>(binding, context, args...);
 }
 
 template <typename T, typename... args_types>
@@ -52,14 +116,17 @@ inline T instance_activator::activate_raii(
         activation_context& context,
         args_types... args) const
 {
-    auto allocated = allocate<T, args_types...>(context, args...);
-    auto deleter = allocated.second;
-
-    auto raii_instance = std::move(*allocated.first);
-    if (deleter)
-        deleter(allocated.first);
+    auto& binding = find<T, args_types...>(context.id()).second.template bound<T, args_types...>();
+    return activate_raii<T, args_types...>(binding, context, args...);
+}
 
-    return std::move(raii_instance);
+template <typename T, typename... args_types>
+inline unique_ref<T> instance_activator::activate_unique_ref(
+        activation_context& context,
+        args_types... args) const
+{
+    auto& binding = find<T, args_types...>(context.id()).second.template bound<T, args_types...>();
+    return activate_unique_ref<T, args_types...>(binding, context, args...);
 }
 
 template <typename T, typename... args_types>
@@ -72,6 +139,42 @@ inline bool instance_activator::can_activate(
     return search_result != definitions_.end();
 }
 
+template <typename T, typename... args_types>
+inline activator_handle<T, args_types...> instance_activator::resolve(
+        const std::string& id) const
+{
+    auto& found = find<T, args_types...>(id);
+    auto& binding = found.second.template bound<T, args_types...>();
+
+    return resolve<T, args_types...>(binding);
+}
+
+template <typename T, typename... args_types>
+inline activator_handle<T, args_types...> instance_activator::resolve(
+        const definition::binding<T, args_types...>& binding) const
+{
+    return activator_handle<T, args_types...>(*this, *binding.id, binding);
+}
+
+template <typename T, typename... args_types>
+inline activator_handle<T, args_types...> instance_activator::resolve_default() const
+{
+    return resolve<T, args_types...>(definition::default_id);
+}
+
+template <typename T, typename... args_types>
+inline factory<T(args_types...)> instance_activator::activate_factory(
+        const std::string& id) const
+{
+    return factory<T(args_types...)>(resolve<T, args_types...>(id));
+}
+
+template <typename T, typename... args_types>
+inline factory<T(args_types...)> instance_activator::activate_default_factory() const
+{
+    return activate_factory<T, args_types...>(definition::default_id);
+}
+
 template <typename T, typename... args_types>
 inline std::unique_ptr<T> instance_activator::activate_unique(
         const std::string& id,
@@ -99,6 +202,15 @@ inline T instance_activator::activate_raii(
     return activate_raii<T, args_types...>(context, args...);
 }
 
+template <typename T, typename... args_types>
+inline unique_ref<T> instance_activator::activate_unique_ref(
+        const std::string& id,
+        args_types... args) const
+{
+    activation_context context(id, *this);
+    return activate_unique_ref<T, args_types...>(context, args...);
+}
+
 template <typename T, typename... args_types>
 inline std::unique_ptr<T> instance_activator::activate_unique(
         const std::string& id,
@@ -129,6 +241,45 @@ inline T instance_activator::activate_raii(
     return activate_raii<T, args_types...>(context, args...);
 }
 
+template <typename T, typename... args_types>
+inline std::vector<std::unique_ptr<T>> instance_activator::activate_many(
+        const std::string& id,
+        size_t count,
+        args_types... args) const
+{
+    std::vector<std::unique_ptr<T>> instances(count);
+    activate_many<T, args_types...>(id, instances.data(), count, args...);
+
+    return instances;
+}
+
+template <typename T, typename... args_types>
+inline void instance_activator::activate_many(
+        const std::string& id,
+        std::unique_ptr<T>* instances,
+        size_t count,
+        args_types... args) const
+{
+    auto& binding = find<T, args_types...>(id).second.template bound<T, args_types...>();
+
+    activation_context context(id, *this);
+    for (auto i = 0u; i < count; i++)
+        instances[i] = activate_unique<T, args_types...>(binding, context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::future<std::unique_ptr<T>> instance_activator::activate_async(
+        const std::string& id,
+        args_types... args) const
+{
+    auto& binding = find<T, args_types...>(id).second.template bound<T, args_types...>();
+    return tools::thread_pool::shared().submit([this, &binding, id, args...]()
+    {
+        activation_context context(id, *this);
+        return activate_unique<T, args_types...>(binding, context, args...);
+    });
+}
+
 template <typename T, typename... args_types>
 inline bool instance_activator::can_activate_default() const
 {
@@ -156,6 +307,37 @@ inline T instance_activator::activate_default_raii(
     return activate_raii<T, args_types...>(definition::default_id, args...);
 }
 
+template <typename T, typename... args_types>
+inline unique_ref<T> instance_activator::activate_default_unique_ref(
+        args_types... args) const
+{
+    return activate_unique_ref<T, args_types...>(definition::default_id, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::vector<std::unique_ptr<T>> instance_activator::activate_default_many(
+        size_t count,
+        args_types... args) const
+{
+    return activate_many<T, args_types...>(definition::default_id, count, args...);
+}
+
+template <typename T, typename... args_types>
+inline void instance_activator::activate_default_many(
+        std::unique_ptr<T>* instances,
+        size_t count,
+        args_types... args) const
+{
+    activate_many<T, args_types...>(definition::default_id, instances, count, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::future<std::unique_ptr<T>> instance_activator::activate_default_async(
+        args_types... args) const
+{
+    return activate_async<T, args_types...>(definition::default_id, args...);
+}
+
 template <typename T, typename... args_types>
 inline std::unique_ptr<T> instance_activator::activate_default_unique(
         annotations_map&& annotations,
@@ -181,24 +363,23 @@ inline T instance_activator::activate_default_raii(
 }
 
 template <typename T, typename... args_types>
-inline std::pair<T*, const std::function<void(T*)>&> instance_activator::allocate(
-        activation_context& context,
-        args_types... args) const
+inline const definition::map_type::value_type& instance_activator::find(
+        const std::string& id) const
 {
     using namespace std;
     using namespace tools;
 
-    auto definition_id = definition::make_id<T, args_types...>(context.id());
+    auto definition_id = definition::make_id<T, args_types...>(id);
     auto search_result = definitions_.find(definition_id);
     if (search_result == definitions_.end())
     {
         std::stringstream message;
 
         auto type_name = demangle(typeid(T).name());
-        if (context.id() == definition::default_id)
+        if (id == definition::default_id)
             message << "No default definition for type: '" << type_name << "'";
         else
-            message << "No named definition '" << context.id() << "' for type: '" << type_name << "'";
+            message << "No named definition '" << id << "' for type: '" << type_name << "'";
 
         auto args_count = sizeof...(args_types);
         if (args_count > 0u)
@@ -229,37 +410,347 @@ inline std::pair<T*, const std::function<void(T*)>&> instance_activator::allocat
         throw invalid_argument(message.str());
     }
 
-    auto& definition = search_result->second;
-    auto& creator = definition.template creator<T, args_types...>();
-    auto deleter = &definition.template deleter<T>();
+    return *search_result;
+}
 
-    auto& annotations = const_cast<di::definition&>(definition).annotations();
-    context.annotations_ << annotations;
+template <typename T, typename... args_types>
+inline std::unique_ptr<T> instance_activator::activate_unique(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    return activate_owned<unique_ownership, T, args_types...>(binding, context, args...);
+}
 
-    auto instance = creator(context, args...);
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> instance_activator::activate_shared(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    return activate_owned<shared_ownership, T, args_types...>(binding, context, args...);
+}
 
-    auto interceptor_id = interceptor_definition::make_id<T, args_types...>();
-    auto interceptor_range = interceptors_.equal_range(interceptor_id);
-    for (auto iter = interceptor_range.first; iter != interceptor_range.second; ++iter)
+template <typename T, typename... args_types>
+inline T instance_activator::activate_raii(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    return activate_owned<value_ownership, T, args_types...>(binding, context, args...);
+}
+
+template <typename T, typename... args_types>
+inline unique_ref<T> instance_activator::activate_unique_ref(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    return activate_owned<borrowed_ownership, T, args_types...>(binding, context, args...);
+}
+
+template <typename ownership_type, typename T, typename... args_types>
+inline typename ownership_type::template instance_type<T> instance_activator::activate_owned(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    // layers are laid out in an allocation of their own, only a deleter can release them
+    if (!ownership_type::layered::value && layered(binding))
+        throw std::logic_error("Layered decorators require activation as shared or unique_ref instances!");
+
+    auto create = [&]() -> typename ownership_type::template instance_type<T>
     {
-        auto& interceptor_definition = iter->second;
-        auto& interceptor = interceptor_definition.template interceptor<T&, args_types...>();
-        interceptor(*instance, context, args...);
+        auto allocated = allocate<T, args_types...>(binding, context, args...);
+        if (!ownership_type::tracked::value || !(instance_tracking_enabled_ || statistics_enabled_))
+            return ownership_type::template own<T>(allocated.first, allocated.second);
+
+        // the tracked deleter records the release even if handing over fails
+        binding.owner->statistics()->record_acquire(sizeof(T));
+        return ownership_type::template own<T>(allocated.first, binding.tracked(allocated.second));
+    };
+
+    return manage<T, args_types...>(binding, context, create, typename ownership_type::managed(), args...);
+}
+
+template <typename T, typename... args_types>
+inline bool instance_activator::layered(const definition::binding<T, args_types...>& binding)
+{
+    return !binding.decorators.empty()
+            && binding.decorators.back()->type() == decorator_definition::decoration_type::layer;
+}
+
+template <typename T, typename... args_types, typename create_type>
+inline auto instance_activator::manage(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        create_type& create,
+        std::true_type managed,
+        args_types... args) const -> decltype(create())
+{
+    if (!binding.lifetime)
+        return create();
+
+    // waiting within a lifetime mustn't help with unrelated tasks, which might need the same lifetime
+    auto scoped = [&create]()
+    {
+        tools::thread_pool::scope scope;
+        return create();
+    };
+
+    return (*binding.lifetime)(context, args..., scoped);
+}
+
+template <typename T, typename... args_types, typename create_type>
+inline auto instance_activator::manage(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        create_type& create,
+        std::false_type managed,
+        args_types... args) const -> decltype(create())
+{
+    return create();
+}
+
+template <typename D, typename T, typename... args_types>
+inline D* instance_activator::activate_wrapped(
+        const definition::binding<T, args_types...>& binding,
+        const activation_context& context,
+        args_types... args) const
+{
+    // moving out of the outermost layer would slice it
+    if (layered(binding))
+        throw std::logic_error("Layered decorators require activation as shared or unique_ref instances!");
+
+    auto by_value = binding.value_creator && std::all_of(
+            binding.decorators.begin(),
+            binding.decorators.end(),
+            [](const decorator_definition* decorator)
+            {
+                return decorator->type() == decorator_definition::decoration_type::value;
+            });
+
+    if (by_value)
+        return activate_wrapped<D, T, args_types...>(binding, context, std::is_move_constructible<T>(), args...);
+
+    auto decorated = decorate<T, args_types...>(binding, (*binding.creator)(context, args...), context, args...);
+
+    auto instance = decorated.first;
+    auto& deleter = decorated.second;
+    auto release = [instance, &deleter]()
+    {
+        if (deleter)
+            deleter(instance);
+        else
+            delete instance;
+    };
+
+    D* wrapped;
+    try
+    {
+        wrapped = new D(std::move(*instance));
     }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+
+    release();
+    return wrapped;
+}
+
+template <typename D, typename T, typename... args_types>
+inline D* instance_activator::activate_wrapped(
+        const definition::binding<T, args_types...>& binding,
+        const activation_context& context,
+        std::true_type movable,
+        args_types... args) const
+{
+    boost::optional<T> instance((*binding.value_creator)(context, args...));
+
+    for (auto interceptor : binding.interceptors)
+        (*interceptor)(*instance, context, args...);
 
-    auto decorator_id = decorator_definition::make_id<T>();
-    auto decorator_range = decorators_.equal_range(decorator_id);
-    for (auto iter = decorator_range.first; iter != decorator_range.second; ++iter)
+    for (auto interceptor : binding.async_interceptors)
+        dispatcher_->post(*interceptor, *binding.id, typeid(T));
+
+    for (auto decorator : binding.decorators)
+        instance.emplace(decorator->template value_decorator<T>()(std::move(*instance), context));
+
+    return new D(std::move(*instance));
+}
+
+template <typename D, typename T, typename... args_types>
+inline D* instance_activator::activate_wrapped(
+        const definition::binding<T, args_types...>& binding,
+        const activation_context& context,
+        std::false_type movable,
+        args_types... args) const
+{
+    throw std::logic_error("Value creators require a move constructible type!");
+}
+
+template <typename T, typename... args_types>
+inline std::pair<T*, const std::function<void(T*)>&> instance_activator::allocate(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    context.definition_ = binding.owner;
+    if (!instrumented_)
+        return construct<T, args_types...>(binding, context, args...);
+
+    return instrument<T, args_types...>(binding, context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::pair<T*, const std::function<void(T*)>&> instance_activator::instrument(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    using namespace std::chrono;
+
+    auto depth = 0u;
+    for (auto parent = context.parent_; parent != boost::none; parent = parent->parent_)
+        depth++;
+
+    activation_event event { context.id(), typeid(T), depth, context, nanoseconds::zero(), false };
+    if (tracer_)
+        tracer_->begin(event);
+
+    auto started = steady_clock::now();
+    try
+    {
+        auto constructed = construct<T, args_types...>(binding, context, args...);
+        event.elapsed = steady_clock::now() - started;
+
+        if (statistics_enabled_)
+        {
+            binding.owner->statistics()->record(event.elapsed);
+            if (context.parent_ && context.parent_->definition_)
+                context.parent_->definition_->statistics()->record_dependency(binding.owner);
+        }
+
+        if (tracer_)
+            tracer_->end(event);
+
+        return constructed;
+    }
+    catch (...)
+    {
+        event.elapsed = steady_clock::now() - started;
+        event.failed = true;
+
+        if (statistics_enabled_)
+            binding.owner->statistics()->record_failure();
+
+        if (tracer_)
+            tracer_->end(event);
+
+        throw;
+    }
+}
+
+template <typename T, typename... args_types>
+inline std::pair<T*, const std::function<void(T*)>&> instance_activator::construct(
+        const definition::binding<T, args_types...>& binding,
+        activation_context& context,
+        args_types... args) const
+{
+    context.annotations_ << binding.owner->annotations();
+
+    auto& creator = *binding.creator;
+    return decorate<T, args_types...>(binding, creator(context, args...), context, args...);
+}
+
+template <typename T, typename... args_types>
+inline std::pair<T*, const std::function<void(T*)>&> instance_activator::decorate(
+        const definition::binding<T, args_types...>& binding,
+        T* instance,
+        const activation_context& context,
+        args_types... args) const
+{
+    for (auto interceptor : binding.interceptors)
+        (*interceptor)(*instance, context, args...);
+
+    for (auto interceptor : binding.async_interceptors)
+        dispatcher_->post(*interceptor, *binding.id, typeid(T));
+
+    using decoration_type = decorator_definition::decoration_type;
+
+    auto deleter = binding.deleter;
+    auto& decorators = binding.decorators;
+    for (auto i = 0u; i < decorators.size(); i++)
     {
-        auto& decorator_definition = iter->second;
-        auto& decorator = decorator_definition.template decorator<T>();
-        auto decorated = decorator(instance, context);
+        auto& decorator = *decorators[i];
+        switch (decorator.type())
+        {
+            case decoration_type::pointer:
+                instance = decorator.template decorator<T>()(instance, context);
+                deleter = &decorator.template deleter<T>();
+                break;
 
-        instance = decorated;
-        deleter = &decorator_definition.template deleter<T>();
+            case decoration_type::value:
+                instance = decorate_value<T>(decorator, instance, deleter, context, std::is_move_constructible<T>());
+                break;
+
+            case decoration_type::layer:
+            {
+                auto last = i + 1u;
+                while (last < decorators.size() && decorators[last]->type() == decoration_type::layer)
+                    last++;
+
+                instance = decorator_definition::compose_layers<T>(
+                        instance,
+                        *deleter,
+                        decorators.data() + i,
+                        decorators.data() + last);
+                deleter = &decorator.template deleter<T>();
+                i = last - 1u;
+                break;
+            }
+        }
     }
 
     return { instance, *deleter };
 }
 
+template <typename T>
+inline T* instance_activator::decorate_value(
+        const decorator_definition& decorator,
+        T* instance,
+        const std::function<void(T*)>*& deleter,
+        const activation_context& context,
+        std::true_type movable)
+{
+    auto decorated = decorator.template value_decorator<T>()(std::move(*instance), context);
+    if (std::is_nothrow_move_constructible<T>::value && typeid(*instance) == typeid(T))
+    {
+        instance->~T();
+        return new (instance) T(std::move(decorated));
+    }
+
+    auto replacement = new T(std::move(decorated));
+    if (*deleter)
+        (*deleter)(instance);
+    else
+        delete instance;
+
+    deleter = &decorator.template deleter<T>();
+    return replacement;
+}
+
+template <typename T>
+inline T* instance_activator::decorate_value(
+        const decorator_definition& decorator,
+        T* instance,
+        const std::function<void(T*)>*& deleter,
+        const activation_context& context,
+        std::false_type movable)
+{
+    throw std::logic_error("Value decorators require a move constructible type!");
+}
+
 }
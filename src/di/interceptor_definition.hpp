@@ -1,5 +1,7 @@
 #pragma once
 
+#include "async_dispatcher.hpp"
+
 #include <boost/any.hpp>
 
 #include <functional>
@@ -26,6 +28,11 @@ public:
     template <typename interceptor_type>
     explicit interceptor_definition(interceptor_type&& interceptor);
 
+    /**
+     * @brief Creates a definition of an interceptor invoked asynchronously, see **async_dispatcher**.
+     */
+    static interceptor_definition make_async(async_dispatcher::handler_type&& interceptor);
+
     /**
      * @brief Non-copy constructable.
      */
@@ -49,8 +56,48 @@ public:
     template <typename T, typename... args_types>
     const std::function<void(T&, const activation_context&, args_types...)>& interceptor() const;
 
+    bool asynchronous() const;
+
+    const async_dispatcher::handler_type& async_interceptor() const;
+
+    /**
+     * @brief Restricts this interceptor to the definition registered under given id.
+     * @details
+     * Scope is evaluated once for each definition of T when **instance_activator** is constructed, activations of
+     * definitions out of the scope don't invoke this interceptor.
+     */
+    interceptor_definition& for_id(const std::string& id);
+
+    /**
+     * @brief Restricts this interceptor to definitions which ids satisfy predicate_type.
+     * @details
+     * For instance:
+     * @code
+     * struct is_remote
+     * {
+     *      bool operator()(const std::string& id) const
+     *      {
+     *          return id.compare(0u, 7u, "remote.") == 0;
+     *      }
+     * };
+     *
+     * builder.define_interceptor<connection>(&count_connection).when<is_remote>();
+     * @endcode
+     *
+     * @tparam predicate_type Default constructable functor invoked with an id of a definition.
+     */
+    template <typename predicate_type>
+    interceptor_definition& when();
+
+    /**
+     * @brief Checks whether this interceptor applies to the definition registered under given id.
+     */
+    bool applies_to(const std::string& id) const;
+
 private:
     boost::any interceptor_;
+    bool asynchronous_;
+    std::function<bool(const std::string&)> scope_;
 
 };
 
@@ -9,11 +9,21 @@ namespace di {
 template <typename interceptor_type>
 inline interceptor_definition::interceptor_definition(interceptor_type&& interceptor)
     :
-        interceptor_(std::move(interceptor))
+        interceptor_(std::move(interceptor)),
+        asynchronous_(false),
+        scope_()
 {
 
 }
 
+inline interceptor_definition interceptor_definition::make_async(async_dispatcher::handler_type&& interceptor)
+{
+    interceptor_definition definition(std::move(interceptor));
+    definition.asynchronous_ = true;
+
+    return definition;
+}
+
 template <typename T, typename... args_types>
 inline interceptor_definition::id_type interceptor_definition::make_id()
 {
@@ -28,4 +38,36 @@ inline const std::function<void(T&, const activation_context&, args_types...)>&
     return boost::any_cast<const interceptor_function_type&>(interceptor_);
 }
 
+inline bool interceptor_definition::asynchronous() const
+{
+    return asynchronous_;
+}
+
+inline const async_dispatcher::handler_type& interceptor_definition::async_interceptor() const
+{
+    return boost::any_cast<const async_dispatcher::handler_type&>(interceptor_);
+}
+
+inline interceptor_definition& interceptor_definition::for_id(const std::string& id)
+{
+    scope_ = [id](const std::string& other)
+    {
+        return other == id;
+    };
+
+    return *this;
+}
+
+template <typename predicate_type>
+inline interceptor_definition& interceptor_definition::when()
+{
+    scope_ = predicate_type();
+    return *this;
+}
+
+inline bool interceptor_definition::applies_to(const std::string& id) const
+{
+    return !scope_ || scope_(id);
+}
+
 }
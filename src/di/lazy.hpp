@@ -0,0 +1,98 @@
+#pragma once
+
+#include "activator_handle.hpp"
+#include "annotations_map.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+
+namespace di {
+
+/**
+ * @brief A dependency activated on first access.
+ * @details
+ * A lazy dependency captures everything required to activate an instance of T - the resolved definition, activation
+ * arguments and annotations of the requesting context - and postpones activation until the instance is accessed for
+ * the first time. For instance:
+ * @code
+ * definition_builder builder;
+ * builder.define_default<component>([](const activation_context& context) -> component
+ * {
+ *      return component(context.activate_default_lazy<heavy_dependency>());
+ * });
+ *
+ * [...]
+ *
+ * void component::rare_path()
+ * {
+ *      heavy_->method();
+ * }
+ * @endcode
+ *
+ * Activation on first access is thread safe, concurrent accessors wait for the activating thread. If activation
+ * throws, the exception is propagated to the accessor and activation is reattempted on the next access.
+ *
+ * A lazy dependency is valid for as long as the activator which created it is alive.
+ *
+ * @tparam T Activated type.
+ */
+template <typename T>
+class lazy
+{
+public:
+    template <typename... args_types>
+    explicit lazy(
+            const activator_handle<T, args_types...>& handle,
+            const annotations_map& annotations,
+            std::decay_t<args_types>... args);
+
+    /**
+     * @brief Non-copy constructable.
+     */
+    lazy(const lazy& other) = delete;
+    /**
+     * @brief Default move constructable.
+     */
+    lazy(lazy&& other) = default;
+    /**
+     * @brief Non-copy assignable.
+     */
+    lazy& operator=(const lazy& other) = delete;
+    /**
+     * @brief Default move assignable.
+     */
+    lazy& operator=(lazy&& other) = default;
+
+    /**
+     * @brief Checks if the instance has been already activated.
+     */
+    bool is_activated() const;
+
+    /**
+     * @brief Gets the instance, activating it if accessed for the first time.
+     */
+    T* get() const;
+
+    T& operator*() const;
+    T* operator->() const;
+
+private:
+    struct state
+    {
+        std::once_flag once;
+        std::atomic<bool> activated { false };
+        std::function<std::unique_ptr<T>()> activate;
+        std::unique_ptr<T> instance;
+    };
+
+    std::unique_ptr<state> state_;
+
+};
+
+}
+
+#include "lazy.ipp"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "lazy.hpp"
+
+#include <utility>
+
+
+namespace di {
+
+template <typename T>
+template <typename... args_types>
+inline lazy<T>::lazy(
+        const activator_handle<T, args_types...>& handle,
+        const annotations_map& annotations,
+        std::decay_t<args_types>... args)
+    :
+        state_(new state())
+{
+    state_->activate = [handle, annotations, args...]() mutable -> std::unique_ptr<T>
+    {
+        auto activation_annotations = annotations;
+        return handle.activate_unique(std::move(activation_annotations), args...);
+    };
+}
+
+template <typename T>
+inline bool lazy<T>::is_activated() const
+{
+    return state_->activated.load(std::memory_order_acquire);
+}
+
+template <typename T>
+inline T* lazy<T>::get() const
+{
+    auto& current = *state_;
+    std::call_once(current.once, [&current]()
+    {
+        current.instance = current.activate();
+        current.activate = nullptr;
+        current.activated.store(true, std::memory_order_release);
+    });
+
+    return current.instance.get();
+}
+
+template <typename T>
+inline T& lazy<T>::operator*() const
+{
+    return *get();
+}
+
+template <typename T>
+inline T* lazy<T>::operator->() const
+{
+    return get();
+}
+
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <di/tools/aligned_allocator.hpp>
+#include <di/tools/aligned_array.hpp>
+#include <di/tools/function_ref.hpp>
+#include <di/tools/hash.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace di {
+
+class activation_context;
+
+/**
+ * @brief A lifetime sharing a single instance of a definition.
+ * @details
+ * The instance is created on the first shared activation and returned to all subsequent shared activations. Concurrent
+ * first activations wait for the activating thread, hence the instance is created exactly once.
+ *
+ * @tparam T Activated type.
+ * @tparam args_types Activation argument types, have to be empty.
+ */
+template <typename T, typename... args_types>
+class single_instance_lifetime
+{
+public:
+    static_assert(
+            sizeof...(args_types) == 0u,
+            "single instance lifetime can't be applied to definitions with arguments!");
+
+    single_instance_lifetime();
+
+    std::shared_ptr<T> operator()(
+            activation_context& context,
+            args_types... args,
+            tools::function_ref<std::shared_ptr<T>()> create) const;
+
+private:
+    struct state
+    {
+        std::once_flag once;
+        std::shared_ptr<T> instance;
+    };
+
+    std::shared_ptr<state> state_;
+
+};
+
+/**
+ * @brief A lifetime sharing an instance per distinct activation arguments.
+ * @details
+ * Instances are cached by values of activation arguments, which have to be hashable and equality comparable. Cached
+ * instances are split into shards by hash of the arguments, each shard guarded by its own mutex and limited to an
+ * equal part of the capacity - there are never more shards than the capacity, and capacities of all shards add up to
+ * it. Once a shard is full, its least recently activated instance is evicted. Evicted instances live for as long as
+ * they are referenced.
+ *
+ * Instances are created outside of the shard lock. When concurrent activations with equal arguments miss the cache,
+ * each creates an instance, but all of them return the one cached first.
+ *
+ * @tparam T Activated type.
+ * @tparam args_types Activation argument types.
+ */
+template <typename T, typename... args_types>
+class memoized_lifetime
+{
+public:
+    static_assert(
+            sizeof...(args_types) > 0u,
+            "memoized lifetime requires definitions with arguments, use single instance lifetime instead!");
+
+    /**
+     * @brief Creates a lifetime.
+     * @param capacity Maximum number of cached instances.
+     * @param shards_count Number of independently locked shards, limited to the capacity.
+     */
+    explicit memoized_lifetime(size_t capacity, size_t shards_count = 16u);
+
+    std::shared_ptr<T> operator()(
+            activation_context& context,
+            args_types... args,
+            tools::function_ref<std::shared_ptr<T>()> create) const;
+
+    /**
+     * @brief Number of cached instances.
+     */
+    size_t size() const;
+
+private:
+    using key_type = std::tuple<std::decay_t<args_types>...>;
+    using entries_type = std::list<std::pair<key_type, std::shared_ptr<T>>>;
+
+    struct shard
+    {
+        std::mutex mutex;
+        size_t capacity;
+        entries_type entries;
+        std::unordered_map<key_type, typename entries_type::iterator, tools::tuple_hash> index;
+    };
+
+    struct state
+    {
+        state(size_t capacity, size_t shards_count);
+
+        std::vector<shard> shards;
+    };
+
+    std::shared_ptr<state> state_;
+
+};
+
+/**
+ * @brief A lifetime sharing an instance for as long as it's referenced.
+ * @details
+ * Shared activations return the instance activated previously with equal activation arguments, as long as any caller
+ * still holds it. Otherwise a new instance is created. The lifetime doesn't keep instances alive, entries of
+ * destroyed instances are purged as the cache grows.
+ *
+ * Instances are created outside of the lock. When concurrent activations with equal arguments find no live instance,
+ * each creates an instance, but all of them return the one cached first.
+ *
+ * @tparam T Activated type.
+ * @tparam args_types Activation argument types, have to be hashable and equality comparable.
+ */
+template <typename T, typename... args_types>
+class weak_instance_lifetime
+{
+public:
+    weak_instance_lifetime();
+
+    std::shared_ptr<T> operator()(
+            activation_context& context,
+            args_types... args,
+            tools::function_ref<std::shared_ptr<T>()> create) const;
+
+    /**
+     * @brief Number of cached entries, including entries of destroyed instances not purged yet.
+     */
+    size_t size() const;
+
+private:
+    using key_type = std::tuple<std::decay_t<args_types>...>;
+
+    struct state
+    {
+        std::mutex mutex;
+        std::unordered_map<key_type, std::weak_ptr<T>, tools::tuple_hash> instances;
+        size_t purge_threshold;
+    };
+
+    std::shared_ptr<state> state_;
+
+};
+
+template <typename T>
+class per_cpu_shards;
+
+/**
+ * @brief A lifetime sharing an instance per CPU.
+ * @details
+ * Shared activations return the instance of the CPU the activating thread runs on, created on the first activation on
+ * that CPU. On Linux the CPU is read with **sched_getcpu**, elsewhere threads are spread over shards by their ids.
+ * Instances are intended for write-heavy components (counters, histograms) aggregated through **per_cpu_shards**.
+ *
+ * A thread can be migrated to another CPU right after its instance is selected, hence instances still have to be
+ * thread safe - the lifetime only makes contention unlikely. Shard slots are aligned to a cache line. Created instances
+ * of move constructible types are moved into storage aligned to a cache line, together with their reference counts, so
+ * instances of different CPUs never share a cache line. Instances of other types, or decorated with derived types, are
+ * kept where the definition allocated them and should be padded to a cache line themselves to avoid false sharing.
+ *
+ * @tparam T Activated type.
+ * @tparam args_types Activation argument types, have to be empty.
+ */
+template <typename T, typename... args_types>
+class per_cpu_lifetime
+{
+public:
+    static_assert(
+            sizeof...(args_types) == 0u,
+            "per CPU lifetime can't be applied to definitions with arguments!");
+
+    /**
+     * @brief Creates a lifetime.
+     * @param shards_count Number of shards, the number of hardware threads when 0.
+     */
+    explicit per_cpu_lifetime(size_t shards_count = 0u);
+
+    std::shared_ptr<T> operator()(
+            activation_context& context,
+            args_types... args,
+            tools::function_ref<std::shared_ptr<T>()> create) const;
+
+    /**
+     * @brief Gets shards of this lifetime.
+     */
+    per_cpu_shards<T> shards() const;
+
+private:
+    friend per_cpu_shards<T>;
+
+    static constexpr size_t cache_line_size = 64u;
+
+    struct slot_instance
+    {
+        std::once_flag once;
+        std::atomic<bool> created;
+        std::shared_ptr<T> instance;
+    };
+
+    struct slot : slot_instance
+    {
+        char padding[cache_line_size - sizeof(slot_instance) % cache_line_size];
+    };
+
+    struct state
+    {
+        explicit state(size_t shards_count);
+
+        const size_t shards_count;
+        tools::aligned_array<slot, cache_line_size> slots;
+    };
+
+    struct aligned_instance
+    {
+        aligned_instance(T&& instance, std::shared_ptr<T> source);
+
+        alignas(cache_line_size) T instance;
+        std::shared_ptr<T> source;
+    };
+
+    static size_t current_shard(size_t shards_count);
+
+    static std::shared_ptr<T> relocate(std::shared_ptr<T> created, std::true_type movable);
+
+    static std::shared_ptr<T> relocate(std::shared_ptr<T> created, std::false_type movable);
+
+    std::shared_ptr<state> state_;
+
+};
+
+/**
+ * @brief Instances of a definition with **per_cpu_lifetime**, for aggregation.
+ * @details
+ * Registered together with the lifetime under the same id, hence it's activated like any other component. For
+ * instance:
+ * @code
+ * builder.define_default<counter>(...).per_cpu();
+ *
+ * [...]
+ *
+ * activator.activate_default_shared<counter>()->increment();
+ *
+ * auto total = 0u;
+ * for (auto& shard : activator.activate_default_raii<per_cpu_shards<counter>>().instances())
+ *      total += shard->value();
+ * @endcode
+ *
+ * @tparam T Activated type.
+ */
+template <typename T>
+class per_cpu_shards
+{
+public:
+    /**
+     * @brief Instances created so far, one per CPU on which the definition has been activated.
+     */
+    std::vector<std::shared_ptr<T>> instances() const;
+
+    /**
+     * @brief Number of shards of the lifetime.
+     */
+    size_t size() const;
+
+private:
+    friend per_cpu_lifetime<T>;
+
+    using state_type = typename per_cpu_lifetime<T>::state;
+
+    explicit per_cpu_shards(std::shared_ptr<state_type> state);
+
+    std::shared_ptr<state_type> state_;
+
+};
+
+}
+
+#include "lifetime.ipp"
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "lifetime.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <typeinfo>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+
+namespace di {
+
+template <typename T, typename... args_types>
+inline single_instance_lifetime<T, args_types...>::single_instance_lifetime()
+    : state_(std::make_shared<state>())
+{
+
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> single_instance_lifetime<T, args_types...>::operator()(
+        activation_context& context,
+        args_types... args,
+        tools::function_ref<std::shared_ptr<T>()> create) const
+{
+    auto& current = *state_;
+    std::call_once(current.once, [&current, &create]()
+    {
+        current.instance = create();
+    });
+
+    return current.instance;
+}
+
+template <typename T, typename... args_types>
+inline memoized_lifetime<T, args_types...>::state::state(size_t capacity, size_t shards_count)
+    : shards(std::max<size_t>(std::min(shards_count, capacity), 1u))
+{
+    // the remainder of the capacity is spread over the first shards, so capacities of all shards add up to it
+    for (size_t i = 0u; i < shards.size(); i++)
+        shards[i].capacity = capacity / shards.size() + (i < capacity % shards.size() ? 1u : 0u);
+}
+
+template <typename T, typename... args_types>
+inline memoized_lifetime<T, args_types...>::memoized_lifetime(size_t capacity, size_t shards_count)
+    : state_(std::make_shared<state>(capacity, shards_count))
+{
+
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> memoized_lifetime<T, args_types...>::operator()(
+        activation_context& context,
+        args_types... args,
+        tools::function_ref<std::shared_ptr<T>()> create) const
+{
+    auto& current = *state_;
+
+    key_type key(args...);
+    auto& selected = current.shards[tools::tuple_hash()(key) % current.shards.size()];
+    {
+        std::lock_guard<std::mutex> lock(selected.mutex);
+        auto found = selected.index.find(key);
+        if (found != selected.index.end())
+        {
+            selected.entries.splice(selected.entries.begin(), selected.entries, found->second);
+            return found->second->second;
+        }
+    }
+
+    auto created = create();
+
+    // evicted instance is released once the shard is unlocked
+    std::shared_ptr<T> evicted;
+    std::lock_guard<std::mutex> lock(selected.mutex);
+    auto found = selected.index.find(key);
+    if (found != selected.index.end())
+    {
+        selected.entries.splice(selected.entries.begin(), selected.entries, found->second);
+        return found->second->second;
+    }
+
+    selected.entries.emplace_front(std::move(key), created);
+    selected.index.emplace(selected.entries.front().first, selected.entries.begin());
+    if (selected.entries.size() > selected.capacity)
+    {
+        evicted = std::move(selected.entries.back().second);
+        selected.index.erase(selected.entries.back().first);
+        selected.entries.pop_back();
+    }
+
+    return created;
+}
+
+template <typename T, typename... args_types>
+inline size_t memoized_lifetime<T, args_types...>::size() const
+{
+    size_t size = 0u;
+    for (auto& current : state_->shards)
+    {
+        std::lock_guard<std::mutex> lock(current.mutex);
+        size += current.entries.size();
+    }
+
+    return size;
+}
+
+template <typename T, typename... args_types>
+inline weak_instance_lifetime<T, args_types...>::weak_instance_lifetime()
+    : state_(std::make_shared<state>())
+{
+    state_->purge_threshold = 16u;
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> weak_instance_lifetime<T, args_types...>::operator()(
+        activation_context& context,
+        args_types... args,
+        tools::function_ref<std::shared_ptr<T>()> create) const
+{
+    auto& current = *state_;
+
+    key_type key(args...);
+    {
+        std::lock_guard<std::mutex> lock(current.mutex);
+        auto found = current.instances.find(key);
+        if (found != current.instances.end())
+        {
+            auto instance = found->second.lock();
+            if (instance)
+                return instance;
+        }
+    }
+
+    auto created = create();
+
+    std::lock_guard<std::mutex> lock(current.mutex);
+    auto& cached = current.instances[key];
+    auto instance = cached.lock();
+    if (instance)
+        return instance;
+
+    cached = created;
+    if (current.instances.size() >= current.purge_threshold)
+    {
+        for (auto entry = current.instances.begin(); entry != current.instances.end();)
+        {
+            if (entry->second.expired())
+                entry = current.instances.erase(entry);
+            else
+                ++entry;
+        }
+
+        // purging again once the number of entries doubles keeps purges amortised constant per activation
+        current.purge_threshold = std::max<size_t>(current.instances.size() * 2u, 16u);
+    }
+
+    return created;
+}
+
+template <typename T, typename... args_types>
+inline size_t weak_instance_lifetime<T, args_types...>::size() const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->instances.size();
+}
+
+template <typename T, typename... args_types>
+constexpr size_t per_cpu_lifetime<T, args_types...>::cache_line_size;
+
+template <typename T, typename... args_types>
+inline per_cpu_lifetime<T, args_types...>::state::state(size_t shards_count)
+    :
+        shards_count(shards_count),
+        slots(shards_count)
+{
+    for (size_t i = 0u; i < shards_count; i++)
+        slots[i].created.store(false, std::memory_order_relaxed);
+}
+
+template <typename T, typename... args_types>
+inline per_cpu_lifetime<T, args_types...>::per_cpu_lifetime(size_t shards_count)
+    : state_(std::make_shared<state>(
+            shards_count > 0u ? shards_count : std::max<size_t>(std::thread::hardware_concurrency(), 1u)))
+{
+
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> per_cpu_lifetime<T, args_types...>::operator()(
+        activation_context& context,
+        args_types... args,
+        tools::function_ref<std::shared_ptr<T>()> create) const
+{
+    auto& current = state_->slots[current_shard(state_->shards_count)];
+    std::call_once(current.once, [&current, &create]()
+    {
+        current.instance = relocate(create(), std::is_move_constructible<T>());
+        current.created.store(true, std::memory_order_release);
+    });
+
+    return current.instance;
+}
+
+template <typename T, typename... args_types>
+inline per_cpu_shards<T> per_cpu_lifetime<T, args_types...>::shards() const
+{
+    return per_cpu_shards<T>(state_);
+}
+
+template <typename T, typename... args_types>
+inline per_cpu_lifetime<T, args_types...>::aligned_instance::aligned_instance(T&& instance, std::shared_ptr<T> source)
+    :
+        instance(std::move(instance)),
+        source(std::move(source))
+{
+
+}
+
+template <typename T, typename... args_types>
+inline size_t per_cpu_lifetime<T, args_types...>::current_shard(size_t shards_count)
+{
+#ifdef __linux__
+    auto cpu = sched_getcpu();
+    if (cpu >= 0)
+        return static_cast<size_t>(cpu) % shards_count;
+#endif
+
+    static thread_local auto index = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return index % shards_count;
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> per_cpu_lifetime<T, args_types...>::relocate(
+        std::shared_ptr<T> created,
+        std::true_type movable)
+{
+    if (!created || typeid(*created) != typeid(T))
+        return created;
+
+    // the moved from instance is kept until the relocated one is released, hence its deleter runs as late as before
+    auto relocated = std::allocate_shared<aligned_instance>(
+            tools::aligned_allocator<aligned_instance, cache_line_size>(),
+            std::move(*created),
+            created);
+
+    return std::shared_ptr<T>(relocated, &relocated->instance);
+}
+
+template <typename T, typename... args_types>
+inline std::shared_ptr<T> per_cpu_lifetime<T, args_types...>::relocate(
+        std::shared_ptr<T> created,
+        std::false_type movable)
+{
+    return created;
+}
+
+template <typename T>
+inline per_cpu_shards<T>::per_cpu_shards(std::shared_ptr<state_type> state)
+    : state_(std::move(state))
+{
+
+}
+
+template <typename T>
+inline std::vector<std::shared_ptr<T>> per_cpu_shards<T>::instances() const
+{
+    std::vector<std::shared_ptr<T>> instances;
+    for (size_t i = 0u; i < state_->shards_count; i++)
+    {
+        auto& current = state_->slots[i];
+        if (current.created.load(std::memory_order_acquire))
+            instances.push_back(current.instance);
+    }
+
+    return instances;
+}
+
+template <typename T>
+inline size_t per_cpu_shards<T>::size() const
+{
+    return state_->shards_count;
+}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "unique_ref.hpp"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+
+namespace di {
+
+/**
+ * @brief Ownership of an activated instance returned by value, as with **activate_raii**.
+ * @details
+ * Ownership policies define how **instance_activator** hands over an allocated instance. All activation modes share
+ * the same pipeline - context, allocation, interception and decoration - and differ only in their ownership policy.
+ * An empty deleter registered with a definition means the instance is released with **delete**.
+ *
+ * Only policies releasing instances with the registered deleter can hand over instances decorated with layers, as
+ * marked with **layered**, and count live instances, as marked with **tracked**. While live instances are tracked,
+ * such policies are given a tracked deleter recording the release of the instance.
+ */
+struct value_ownership
+{
+    using managed = std::false_type;
+    using layered = std::false_type;
+    using tracked = std::false_type;
+
+    template <typename T>
+    using instance_type = T;
+
+    template <typename T>
+    static T own(T* instance, const std::function<void(T*)>& deleter);
+};
+
+/**
+ * @brief Ownership of an activated instance returned as **std::unique_ptr**, released with **delete**.
+ * @details
+ * The default deleter of **std::unique_ptr** can't record a release, unique instances aren't counted when live
+ * instances are tracked.
+ */
+struct unique_ownership
+{
+    using managed = std::false_type;
+    using layered = std::false_type;
+    using tracked = std::false_type;
+
+    template <typename T>
+    using instance_type = std::unique_ptr<T>;
+
+    template <typename T>
+    static std::unique_ptr<T> own(T* instance, const std::function<void(T*)>& deleter);
+};
+
+/**
+ * @brief Ownership of an activated instance returned as **std::shared_ptr**, released with the registered deleter.
+ * @details
+ * Shared instances are managed by the lifetime of their definition, if it has any. The deleter is copied, hence shared
+ * instances can outlive the activator.
+ */
+struct shared_ownership
+{
+    using managed = std::true_type;
+    using layered = std::true_type;
+    using tracked = std::true_type;
+
+    template <typename T>
+    using instance_type = std::shared_ptr<T>;
+
+    template <typename T>
+    static std::shared_ptr<T> own(T* instance, const std::function<void(T*)>& deleter);
+};
+
+/**
+ * @brief Ownership of an activated instance borrowed from its factory, returned as **unique_ref** releasing the
+ * instance with the registered deleter.
+ */
+struct borrowed_ownership
+{
+    using managed = std::false_type;
+    using layered = std::true_type;
+    using tracked = std::true_type;
+
+    template <typename T>
+    using instance_type = unique_ref<T>;
+
+    template <typename T>
+    static unique_ref<T> own(T* instance, const std::function<void(T*)>& deleter);
+};
+
+}
+
+#include "ownership.ipp"
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ownership.hpp"
+
+#include <utility>
+
+
+namespace di {
+
+template <typename T>
+inline T value_ownership::own(T* instance, const std::function<void(T*)>& deleter)
+{
+    T value = std::move(*instance);
+    if (deleter)
+        deleter(instance);
+    else
+        delete instance;
+
+    return value;
+}
+
+template <typename T>
+inline std::unique_ptr<T> unique_ownership::own(T* instance, const std::function<void(T*)>& deleter)
+{
+    return std::unique_ptr<T>(instance);
+}
+
+template <typename T>
+inline std::shared_ptr<T> shared_ownership::own(T* instance, const std::function<void(T*)>& deleter)
+{
+    if (!deleter)
+        return std::shared_ptr<T>(instance);
+
+    return std::shared_ptr<T>(instance, deleter);
+}
+
+template <typename T>
+inline unique_ref<T> borrowed_ownership::own(T* instance, const std::function<void(T*)>& deleter)
+{
+    return unique_ref<T>(instance, di::deleter<T>(deleter));
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+
+
+namespace di { namespace tools {
+
+/**
+ * @brief An allocator aligning allocations to a given boundary.
+ * @details
+ * Allocations start at the alignment boundary and are padded to a multiple of the alignment, hence with a cache line
+ * alignment no two allocations share a cache line. Intended for **std::allocate_shared** of instances updated
+ * concurrently from different CPUs.
+ *
+ * @tparam T Allocated type.
+ * @tparam alignment Alignment of allocations, a power of 2.
+ */
+template <typename T, size_t alignment>
+class aligned_allocator
+{
+public:
+    static_assert((alignment & (alignment - 1u)) == 0u, "alignment has to be a power of 2!");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, alignment>& other);
+
+    /**
+     * @brief Allocates aligned storage for a number of elements.
+     * @param size Number of elements.
+     */
+    T* allocate(size_t size);
+
+    /**
+     * @brief Releases storage allocated with **allocate**.
+     * @param elements Allocated elements.
+     * @param size Number of elements.
+     */
+    void deallocate(T* elements, size_t size);
+
+};
+
+template <typename T, typename U, size_t alignment>
+bool operator==(const aligned_allocator<T, alignment>& lhs, const aligned_allocator<U, alignment>& rhs);
+
+template <typename T, typename U, size_t alignment>
+bool operator!=(const aligned_allocator<T, alignment>& lhs, const aligned_allocator<U, alignment>& rhs);
+
+} }
+
+#include "aligned_allocator.ipp"
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+
+#include <cstdint>
+#include <new>
+
+
+namespace di { namespace tools {
+
+template <typename T, size_t alignment>
+template <typename U>
+inline aligned_allocator<T, alignment>::aligned_allocator(const aligned_allocator<U, alignment>& other)
+{
+
+}
+
+template <typename T, size_t alignment>
+inline T* aligned_allocator<T, alignment>::allocate(size_t size)
+{
+    // the address of the whole block is stored right before the aligned storage
+    auto padded = (sizeof(T) * size + alignment - 1u) & ~static_cast<size_t>(alignment - 1u);
+    auto storage = ::operator new(padded + alignment + sizeof(void*));
+
+    auto address = reinterpret_cast<uintptr_t>(storage) + sizeof(void*);
+    auto aligned = (address + alignment - 1u) & ~static_cast<uintptr_t>(alignment - 1u);
+    reinterpret_cast<void**>(aligned)[-1] = storage;
+
+    return reinterpret_cast<T*>(aligned);
+}
+
+template <typename T, size_t alignment>
+inline void aligned_allocator<T, alignment>::deallocate(T* elements, size_t size)
+{
+    ::operator delete(reinterpret_cast<void**>(elements)[-1]);
+}
+
+template <typename T, typename U, size_t alignment>
+inline bool operator==(const aligned_allocator<T, alignment>& lhs, const aligned_allocator<U, alignment>& rhs)
+{
+    return true;
+}
+
+template <typename T, typename U, size_t alignment>
+inline bool operator!=(const aligned_allocator<T, alignment>& lhs, const aligned_allocator<U, alignment>& rhs)
+{
+    return false;
+}
+
+} }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+
+namespace di { namespace tools {
+
+/**
+ * @brief A fixed size array of default constructed elements aligned to a given boundary.
+ * @details
+ * **operator new** aligns allocations only to the fundamental alignment, over-aligned types (or padded types intended
+ * to occupy whole cache lines) allocated with **new[]** can start anywhere within a cache line. The array over-allocates
+ * its storage and aligns the first element by hand, each element is aligned when its size is a multiple of the
+ * alignment.
+ *
+ * @tparam T Element type, default constructible.
+ * @tparam alignment Alignment of elements, a power of 2.
+ */
+template <typename T, size_t alignment>
+class aligned_array
+{
+public:
+    static_assert((alignment & (alignment - 1u)) == 0u, "alignment has to be a power of 2!");
+    static_assert(sizeof(T) % alignment == 0u, "element size has to be a multiple of the alignment!");
+
+    /**
+     * @brief Creates an array of default constructed elements.
+     * @param size Number of elements.
+     */
+    explicit aligned_array(size_t size);
+
+    /**
+     * @brief Non-copy constructable.
+     */
+    aligned_array(const aligned_array& other) = delete;
+    /**
+     * @brief Non-copy assignable.
+     */
+    aligned_array& operator=(const aligned_array& other) = delete;
+
+    ~aligned_array();
+
+    T& operator[](size_t index);
+
+    const T& operator[](size_t index) const;
+
+    size_t size() const;
+
+private:
+    std::unique_ptr<char[]> storage_;
+    T* elements_;
+    size_t size_;
+
+};
+
+} }
+
+#include "aligned_array.ipp"
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "aligned_array.hpp"
+
+#include <cstdint>
+#include <new>
+
+
+namespace di { namespace tools {
+
+template <typename T, size_t alignment>
+inline aligned_array<T, alignment>::aligned_array(size_t size)
+    :
+        storage_(new char[sizeof(T) * size + alignment]),
+        elements_(nullptr),
+        size_(0u)
+{
+    auto address = reinterpret_cast<uintptr_t>(storage_.get());
+    auto aligned = (address + alignment - 1u) & ~static_cast<uintptr_t>(alignment - 1u);
+    elements_ = reinterpret_cast<T*>(aligned);
+
+    try
+    {
+        for (; size_ < size; size_++)
+            new (&elements_[size_]) T();
+    }
+    catch (...)
+    {
+        while (size_ > 0u)
+            elements_[--size_].~T();
+
+        throw;
+    }
+}
+
+template <typename T, size_t alignment>
+inline aligned_array<T, alignment>::~aligned_array()
+{
+    while (size_ > 0u)
+        elements_[--size_].~T();
+}
+
+template <typename T, size_t alignment>
+inline T& aligned_array<T, alignment>::operator[](size_t index)
+{
+    return elements_[index];
+}
+
+template <typename T, size_t alignment>
+inline const T& aligned_array<T, alignment>::operator[](size_t index) const
+{
+    return elements_[index];
+}
+
+template <typename T, size_t alignment>
+inline size_t aligned_array<T, alignment>::size() const
+{
+    return size_;
+}
+
+} }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <type_traits>
+
+
+namespace di { namespace tools {
+
+/**
+ * @brief Casts a pointer to a base type back to the derived type it has been upcast from.
+ * @details
+ * Resolves to **static_cast** whenever the base isn't virtual, **dynamic_cast** is used otherwise.
+ *
+ * @tparam derived_type Type the pointer has been upcast from.
+ * @tparam base_type Base type of derived_type.
+ */
+template <typename derived_type, typename base_type>
+derived_type* downcast(base_type* pointer);
+
+} }
+
+#include "downcast.ipp"
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "downcast.hpp"
+
+#include <utility>
+
+
+namespace di { namespace tools {
+
+namespace detail {
+
+template <typename derived_type, typename base_type, typename = void>
+struct is_static_downcastable : std::false_type
+{ };
+
+template <typename derived_type, typename base_type>
+struct is_static_downcastable<
+        derived_type,
+        base_type,
+        decltype(static_cast<derived_type*>(std::declval<base_type*>()), void())> : std::true_type
+{ };
+
+template <typename derived_type, typename base_type>
+inline derived_type* downcast(base_type* pointer, std::true_type)
+{
+    return static_cast<derived_type*>(pointer);
+}
+
+template <typename derived_type, typename base_type>
+inline derived_type* downcast(base_type* pointer, std::false_type)
+{
+    return dynamic_cast<derived_type*>(pointer);
+}
+
+}
+
+template <typename derived_type, typename base_type>
+inline derived_type* downcast(base_type* pointer)
+{
+    static_assert(
+            std::is_base_of<base_type, derived_type>::value,
+            "base_type has to be a base of derived_type!");
+
+    return detail::downcast<derived_type>(
+            pointer,
+            detail::is_static_downcastable<derived_type, base_type>());
+}
+
+} }
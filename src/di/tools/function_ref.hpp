@@ -0,0 +1,53 @@
+#pragma once
+
+#include <type_traits>
+
+
+namespace di { namespace tools {
+
+template <typename signature_type>
+class function_ref;
+
+/**
+ * @brief A non-owning reference to a callable.
+ * @details
+ * Unlike **std::function**, **function_ref** neither copies nor allocates the referenced callable. It is intended to
+ * pass callbacks down the call stack, the referenced callable has to outlive the reference.
+ *
+ * @tparam return_type Callable return type.
+ * @tparam args_types Callable argument types.
+ */
+template <typename return_type, typename... args_types>
+class function_ref<return_type(args_types...)>
+{
+public:
+    template <
+            typename callable_type,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<callable_type>, function_ref>::value>>
+    function_ref(callable_type&& callable);
+
+    /**
+     * @brief Default copy constructable.
+     */
+    function_ref(const function_ref& other) = default;
+    /**
+     * @brief Default copy assignable.
+     */
+    function_ref& operator=(const function_ref& other) = default;
+
+    return_type operator()(args_types... args) const;
+
+private:
+    using invoker_type = return_type (*)(void*, args_types...);
+
+    template <typename callable_type>
+    static return_type invoke(void* callable, args_types... args);
+
+    void* callable_;
+    invoker_type invoker_;
+
+};
+
+} }
+
+#include "function_ref.ipp"
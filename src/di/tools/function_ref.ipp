@@ -0,0 +1,34 @@
+#pragma once
+
+#include "function_ref.hpp"
+
+#include <memory>
+#include <utility>
+
+
+namespace di { namespace tools {
+
+template <typename return_type, typename... args_types>
+template <typename callable_type, typename>
+inline function_ref<return_type(args_types...)>::function_ref(callable_type&& callable)
+    :
+        callable_(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+        invoker_(&invoke<std::remove_reference_t<callable_type>>)
+{
+
+}
+
+template <typename return_type, typename... args_types>
+inline return_type function_ref<return_type(args_types...)>::operator()(args_types... args) const
+{
+    return invoker_(callable_, std::forward<args_types>(args)...);
+}
+
+template <typename return_type, typename... args_types>
+template <typename callable_type>
+inline return_type function_ref<return_type(args_types...)>::invoke(void* callable, args_types... args)
+{
+    return (*static_cast<callable_type*>(callable))(std::forward<args_types>(args)...);
+}
+
+} }
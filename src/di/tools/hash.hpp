@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <tuple>
 #include <utility>
 
 
@@ -12,6 +13,19 @@ struct pair_hash
     size_t operator()(const std::pair<T1,T2> &p) const;
 };
 
+/**
+ * @brief Combines hashes of all tuple elements, sensitive to their order.
+ */
+struct tuple_hash
+{
+    template <typename... types>
+    size_t operator()(const std::tuple<types...>& t) const;
+
+private:
+    template <typename tuple_type, size_t... indexes>
+    static size_t combine(const tuple_type& t, std::index_sequence<indexes...>);
+};
+
 } }
 
 namespace std {
@@ -15,6 +15,26 @@ inline size_t pair_hash::operator ()(const std::pair<T1, T2>& p) const
     return h1 ^ h2;
 }
 
+template <typename... types>
+inline size_t tuple_hash::operator()(const std::tuple<types...>& t) const
+{
+    return combine(t, std::index_sequence_for<types...>());
+}
+
+template <typename tuple_type, size_t... indexes>
+inline size_t tuple_hash::combine(const tuple_type& t, std::index_sequence<indexes...>)
+{
+    size_t seed = 0u;
+    auto elements = {
+        (seed ^= std::hash<std::tuple_element_t<indexes, tuple_type>>{}(std::get<indexes>(t))
+                + 0x9e3779b9u + (seed << 6u) + (seed >> 2u))...,
+        seed
+    };
+    (void)elements;
+
+    return seed;
+}
+
 } }
 
 namespace std {
@@ -0,0 +1,136 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+
+
+namespace di { namespace tools {
+
+namespace {
+
+atomic<uint64_t> next_scope(1u);
+thread_local uint64_t current_scope = 0u;
+
+}
+
+thread_pool::scope::scope()
+    : previous_(current())
+{
+    current_scope = next_scope.fetch_add(1u, memory_order_relaxed);
+}
+
+thread_pool::scope::~scope()
+{
+    current_scope = previous_;
+}
+
+uint64_t thread_pool::scope::current()
+{
+    if (current_scope == 0u)
+        current_scope = next_scope.fetch_add(1u, memory_order_relaxed);
+
+    return current_scope;
+}
+
+thread_pool::thread_pool(size_t concurrency)
+    :
+        stopped_(false)
+{
+    concurrency = max<size_t>(concurrency, 1u);
+    for (auto i = 0u; i < concurrency; i++)
+        workers_.emplace_back(&thread_pool::work, this);
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    available_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+thread_pool& thread_pool::shared()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+size_t thread_pool::concurrency() const
+{
+    return workers_.size();
+}
+
+bool thread_pool::run_pending()
+{
+    task pending;
+    {
+        lock_guard<mutex> lock(mutex_);
+        if (tasks_.empty())
+            return false;
+
+        pending = std::move(tasks_.front());
+        tasks_.pop_front();
+    }
+
+    execute(pending);
+    return true;
+}
+
+bool thread_pool::run_pending(uint64_t scope)
+{
+    task pending;
+    {
+        lock_guard<mutex> lock(mutex_);
+        auto owned = find_if(tasks_.begin(), tasks_.end(), [scope](const task& candidate)
+        {
+            return candidate.scope == scope;
+        });
+
+        if (owned == tasks_.end())
+            return false;
+
+        pending = std::move(*owned);
+        tasks_.erase(owned);
+    }
+
+    execute(pending);
+    return true;
+}
+
+void thread_pool::execute(task& task)
+{
+    // tasks submitted by the task are owned by it, rather than by its submitter
+    scope scope;
+    task.function();
+}
+
+void thread_pool::work()
+{
+    while (true)
+    {
+        task pending;
+        {
+            unique_lock<mutex> lock(mutex_);
+            available_.wait(lock, [this]()
+            {
+                return stopped_ || !tasks_.empty();
+            });
+
+            if (tasks_.empty())
+                return;
+
+            pending = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        execute(pending);
+    }
+}
+
+} }
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace di { namespace tools {
+
+/**
+ * @brief A fixed size pool of worker threads executing submitted tasks in submission order.
+ * @details
+ * A thread waiting for a task submitted to the pool should use **wait**, which executes pending tasks on the waiting
+ * thread until the awaited task completes. This allows tasks to submit and await other tasks without exhausting
+ * workers of the pool. Only tasks submitted within the **scope** of the waiting thread are executed this way, hence
+ * a waiting thread never executes unrelated tasks which could need a resource it holds.
+ */
+class thread_pool final
+{
+public:
+    /**
+     * @brief A scope owning tasks submitted within it.
+     * @details
+     * Each task executes within a scope of its own, outside of tasks each thread has a scope of its own. A scope
+     * opened around a section which mustn't execute unrelated tasks while waiting - for instance a section holding a
+     * lock a pending task might need - restricts **wait** to tasks submitted within that section.
+     */
+    class scope final
+    {
+    public:
+        scope();
+
+        /**
+         * @brief Non-copy constructable.
+         */
+        scope(const scope& other) = delete;
+        /**
+         * @brief Non-copy assignable.
+         */
+        scope& operator=(const scope& other) = delete;
+
+        ~scope();
+
+        /**
+         * @brief Id of the innermost scope of the calling thread.
+         */
+        static uint64_t current();
+
+    private:
+        uint64_t previous_;
+
+    };
+
+    explicit thread_pool(size_t concurrency = std::thread::hardware_concurrency());
+
+    /**
+     * @brief Non-copy constructable.
+     */
+    thread_pool(const thread_pool& other) = delete;
+    /**
+     * @brief Non-move constructable.
+     */
+    thread_pool(thread_pool&& other) = delete;
+    /**
+     * @brief Non-copy assignable.
+     */
+    thread_pool& operator=(const thread_pool& other) = delete;
+    /**
+     * @brief Non-move assignable.
+     */
+    thread_pool& operator=(thread_pool&& other) = delete;
+
+    /**
+     * @brief Completes all submitted tasks and stops workers.
+     */
+    ~thread_pool();
+
+    /**
+     * @brief A process wide pool shared by asynchronous activations.
+     * @details
+     * The pool is created on first use with one worker per hardware thread.
+     */
+    static thread_pool& shared();
+
+    size_t concurrency() const;
+
+    /**
+     * @brief Submits a task for execution.
+     * @tparam function_type Type of the task.
+     * @param function A task to execute.
+     * @return A future completed with the result of the task.
+     */
+    template <typename function_type>
+    std::future<std::result_of_t<function_type()>> submit(function_type&& function);
+
+    /**
+     * @brief Executes a single pending task on the calling thread, regardless of its scope.
+     * @return **true** if a task has been executed, **false** if no task was pending.
+     */
+    bool run_pending();
+
+    /**
+     * @brief Waits for a future, executing pending tasks of the current scope on the calling thread in the meantime.
+     * @tparam R Future result type.
+     * @param future A future to wait for.
+     * @return Result of the future.
+     */
+    template <typename R>
+    R wait(std::future<R>& future);
+
+private:
+    struct task
+    {
+        uint64_t scope;
+        std::function<void()> function;
+    };
+
+    void work();
+
+    bool run_pending(uint64_t scope);
+
+    static void execute(task& task);
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<task> tasks_;
+    std::vector<std::thread> workers_;
+    bool stopped_;
+
+};
+
+} }
+
+#include "thread_pool.ipp"
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <memory>
+#include <utility>
+
+
+namespace di { namespace tools {
+
+template <typename function_type>
+inline std::future<std::result_of_t<function_type()>> thread_pool::submit(function_type&& function)
+{
+    using result_type = std::result_of_t<function_type()>;
+
+    auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<function_type>(function));
+    auto result = task->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back({ scope::current(), [task]()
+        {
+            (*task)();
+        } });
+    }
+    available_.notify_one();
+
+    return result;
+}
+
+template <typename R>
+inline R thread_pool::wait(std::future<R>& future)
+{
+    using namespace std::chrono;
+
+    auto owner = scope::current();
+    auto status = future.wait_for(seconds(0));
+    while (status == std::future_status::timeout)
+    {
+        if (!run_pending(owner))
+            future.wait_for(milliseconds(1));
+
+        status = future.wait_for(seconds(0));
+    }
+
+    return future.get();
+}
+
+} }
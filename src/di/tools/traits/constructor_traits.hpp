@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+namespace di { namespace tools {
+
+/**
+ * @brief Detects constructor of T which can be invoked with a number of generic arguments.
+ * @details
+ * A generic argument is a type convertible to any parameter type, except of T itself (copy and move constructors are
+ * excluded that way). The greatest arity of an unambiguous constructor is detected. Aggregates, which can't be
+ * constructed with parentheses in C++14, are detected through brace initialisation.
+ *
+ * @tparam T Inspected type.
+ * @tparam argument_type Generic argument type.
+ * @tparam max_arity Greatest inspected arity.
+ */
+template <typename T, typename argument_type, size_t max_arity = 10u>
+struct constructor_traits
+{
+private:
+    template <typename A, size_t>
+    struct repeat
+    {
+        using type = A;
+    };
+
+    template <typename indexes_type>
+    struct is_parenthesis_constructible;
+
+    template <size_t... indexes>
+    struct is_parenthesis_constructible<std::index_sequence<indexes...>>
+        : std::is_constructible<T, typename repeat<argument_type, indexes>::type...>
+    {
+    };
+
+    template <typename indexes_type, typename = void>
+    struct brace_initialisation : std::false_type
+    {
+    };
+
+    template <size_t... indexes>
+    struct brace_initialisation<
+            std::index_sequence<indexes...>,
+            decltype(void(T { std::declval<typename repeat<argument_type, indexes>::type>()... }))>
+        : std::true_type
+    {
+    };
+
+    template <typename indexes_type>
+    struct is_brace_constructible : brace_initialisation<indexes_type>
+    {
+    };
+
+    template <template <typename> class predicate_type, size_t arity = max_arity, typename = void>
+    struct greatest
+        : std::conditional_t<
+                predicate_type<std::make_index_sequence<arity>>::value,
+                std::integral_constant<size_t, arity>,
+                greatest<predicate_type, arity - 1u>>
+    {
+    };
+
+    template <template <typename> class predicate_type, typename dummy_type>
+    struct greatest<predicate_type, 0u, dummy_type> : std::integral_constant<size_t, 0u>
+    {
+    };
+
+    static constexpr size_t parenthesised_arity = greatest<is_parenthesis_constructible>::value;
+    static constexpr size_t braced_arity = greatest<is_brace_constructible>::value;
+
+public:
+    /**
+     * @brief **true** if T has to be constructed with brace initialisation.
+     */
+    static constexpr bool braced =
+            std::is_class<T>::value && parenthesised_arity == 0u && braced_arity > 0u;
+
+    /**
+     * @brief **true** if T can be constructed with generic arguments at all.
+     */
+    static constexpr bool constructible =
+            is_parenthesis_constructible<std::make_index_sequence<parenthesised_arity>>::value ||
+            is_brace_constructible<std::make_index_sequence<braced_arity>>::value;
+
+    /**
+     * @brief Number of arguments accepted by the detected constructor.
+     */
+    static constexpr size_t arity = braced ? braced_arity : parenthesised_arity;
+
+    /**
+     * @brief Index sequence of the detected constructor arguments.
+     */
+    using indexes = std::make_index_sequence<arity>;
+
+};
+
+} }
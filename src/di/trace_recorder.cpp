@@ -0,0 +1,172 @@
+#include "trace_recorder.hpp"
+
+#include <di/tools/cxxabi_utils.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace di {
+
+namespace {
+
+atomic<uint64_t> recorders_count(0u);
+
+string escape(const string& value)
+{
+    string escaped;
+    for (auto character : value)
+    {
+        if (character == '"' || character == '\\')
+            escaped.push_back('\\');
+        if (static_cast<unsigned char>(character) >= 0x20u)
+            escaped.push_back(character);
+    }
+
+    return escaped;
+}
+
+}
+
+constexpr size_t trace_recorder::max_id_length;
+
+trace_recorder::buffer::buffer(size_t capacity, size_t thread_index)
+    :
+        thread_id(this_thread::get_id()),
+        thread_index(thread_index),
+        head(0u),
+        spans(new span[capacity]),
+        next(nullptr)
+{
+
+}
+
+trace_recorder::trace_recorder(size_t capacity)
+    :
+        capacity_(max<size_t>(capacity, 1u) + 1u),
+        recorder_id_(++recorders_count),
+        started_(steady_clock::now()),
+        buffers_(nullptr),
+        threads_count_(0u)
+{
+
+}
+
+trace_recorder::~trace_recorder()
+{
+    auto buffer = buffers_.load(memory_order_acquire);
+    while (buffer)
+    {
+        auto next = buffer->next;
+        delete buffer;
+        buffer = next;
+    }
+}
+
+void trace_recorder::begin(const activation_event& event)
+{
+    // spans are recorded complete, once their duration is known
+}
+
+void trace_recorder::end(const activation_event& event)
+{
+    auto ended = steady_clock::now();
+
+    auto& buffer = local_buffer();
+    auto index = buffer.head.load(memory_order_relaxed);
+
+    auto& span = buffer.spans[index % capacity_];
+    span.type = &event.type;
+    span.started = duration_cast<nanoseconds>(ended - started_ - event.elapsed).count();
+    span.duration = event.elapsed.count();
+    span.depth = static_cast<uint32_t>(event.depth);
+    span.failed = event.failed;
+
+    auto length = min(event.id.size(), max_id_length);
+    memcpy(span.id, event.id.data(), length);
+    span.id[length] = '\0';
+
+    buffer.head.store(index + 1u, memory_order_release);
+}
+
+void trace_recorder::write(ostream& os) const
+{
+    os << "{\"traceEvents\":[";
+
+    auto first = true;
+    for (auto buffer = buffers_.load(memory_order_acquire); buffer; buffer = buffer->next)
+    {
+        auto head = buffer->head.load(memory_order_acquire);
+        auto tail = head > capacity_ ? head - capacity_ : 0u;
+
+        vector<span> spans;
+        spans.reserve(head - tail);
+        for (auto index = tail; index < head; index++)
+            spans.push_back(buffer->spans[index % capacity_]);
+
+        // spans copied before the fence, which the owning thread could have been rewriting meanwhile, are skipped -
+        // including the one at the head, being written before the head is published
+        atomic_thread_fence(memory_order_acquire);
+        auto overwritten = buffer->head.load(memory_order_relaxed);
+        auto valid_from = overwritten + 1u > capacity_ ? overwritten + 1u - capacity_ : 0u;
+
+        for (auto index = max(tail, valid_from); index < head; index++)
+        {
+            auto& span = spans[index - tail];
+
+            os << (first ? "" : ",");
+            os << "{\"name\":\"" << escape(tools::demangle(span.type->name())) << "\"";
+            os << ",\"cat\":\"activation\",\"ph\":\"X\"";
+            os << ",\"ts\":" << fixed << setprecision(3) << span.started / 1000.0;
+            os << ",\"dur\":" << fixed << setprecision(3) << span.duration / 1000.0;
+            os << ",\"pid\":1,\"tid\":" << buffer->thread_index;
+            os << ",\"args\":{\"id\":\"" << escape(span.id) << "\"";
+            os << ",\"depth\":" << span.depth;
+            os << ",\"failed\":" << (span.failed ? "true" : "false") << "}}";
+
+            first = false;
+        }
+    }
+
+    os << "],\"displayTimeUnit\":\"ns\"}" << endl;
+}
+
+trace_recorder::buffer& trace_recorder::local_buffer()
+{
+    struct thread_cache
+    {
+        uint64_t recorder_id;
+        buffer* local;
+    };
+
+    static thread_local thread_cache cached { 0u, nullptr };
+    if (cached.recorder_id == recorder_id_)
+        return *cached.local;
+
+    for (auto existing = buffers_.load(memory_order_acquire); existing; existing = existing->next)
+    {
+        if (existing->thread_id == this_thread::get_id())
+        {
+            cached = { recorder_id_, existing };
+            return *existing;
+        }
+    }
+
+    auto created = new buffer(capacity_, threads_count_.fetch_add(1u, memory_order_relaxed));
+    created->next = buffers_.load(memory_order_relaxed);
+    while (!buffers_.compare_exchange_weak(created->next, created, memory_order_release, memory_order_relaxed))
+        ;
+
+    cached = { recorder_id_, created };
+    return *created;
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "activation_tracer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <typeinfo>
+
+
+namespace di {
+
+/**
+ * @brief An **activation_tracer** recording activation spans for Chrome trace-event viewers.
+ * @details
+ * Each thread records spans into its own ring buffer of a fixed capacity, recording is lock-free and doesn't allocate
+ * once the buffer of a thread exists. When a buffer is full the oldest spans are overwritten. Recorded spans are
+ * written with **write** in Chrome trace-event JSON format, which can be opened with chrome://tracing or Perfetto UI.
+ * For instance:
+ * @code
+ * auto recorder = std::make_shared<di::trace_recorder>();
+ * activator.set_tracer(recorder);
+ *
+ * [...]
+ *
+ * std::ofstream file("activations.json");
+ * recorder->write(file);
+ * @endcode
+ *
+ * Spans written while being recorded are skipped if overwritten during **write**.
+ */
+class trace_recorder : public activation_tracer
+{
+public:
+    /**
+     * @brief Creates a recorder.
+     * @param capacity Number of spans retained per thread.
+     */
+    explicit trace_recorder(size_t capacity = 4096u);
+
+    /**
+     * @brief Non-copy constructable.
+     */
+    trace_recorder(const trace_recorder& other) = delete;
+    /**
+     * @brief Non-copy assignable.
+     */
+    trace_recorder& operator=(const trace_recorder& other) = delete;
+
+    ~trace_recorder() override;
+
+    void begin(const activation_event& event) override;
+
+    void end(const activation_event& event) override;
+
+    /**
+     * @brief Writes recorded spans as Chrome trace-event JSON.
+     * @param os Output stream.
+     */
+    void write(std::ostream& os) const;
+
+private:
+    static constexpr size_t max_id_length = 63u;
+
+    struct span
+    {
+        const std::type_info* type;
+        int64_t started;
+        int64_t duration;
+        uint32_t depth;
+        bool failed;
+        char id[max_id_length + 1u];
+    };
+
+    struct buffer
+    {
+        buffer(size_t capacity, size_t thread_index);
+
+        const std::thread::id thread_id;
+        const size_t thread_index;
+        std::atomic<uint64_t> head;
+        std::unique_ptr<span[]> spans;
+        buffer* next;
+    };
+
+    buffer& local_buffer();
+
+    // one span more than retained, the span at the head may be being written while the buffer is read
+    const size_t capacity_;
+    const uint64_t recorder_id_;
+    const std::chrono::steady_clock::time_point started_;
+
+    std::atomic<buffer*> buffers_;
+    std::atomic<size_t> threads_count_;
+
+};
+
+}
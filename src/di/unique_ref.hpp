@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+
+namespace di {
+
+/**
+ * @brief A deleter of T referencing the deleter registered with a definition of T.
+ * @details
+ * The deleter is a single pointer to the deleter function resolved by **instance_activator** for the activated
+ * definition - the deleter of the last applied decorator or the deleter given when T was defined, or its tracked
+ * counterpart recording the release while live instances are tracked. Instances without a registered deleter are
+ * deleted with **delete**.
+ *
+ * Since the deleter function is owned by the activator, a deleter is valid for as long as the activator which created
+ * it is alive.
+ *
+ * @tparam T Deleted type.
+ */
+template <typename T>
+class deleter
+{
+public:
+    using function_type = std::function<void(T*)>;
+
+    /**
+     * @brief Creates a deleter deleting instances with **delete**.
+     */
+    deleter() noexcept;
+
+    /**
+     * @brief Creates a deleter invoking a deleter function.
+     * @param function Deleter function, **delete** is used when empty.
+     */
+    explicit deleter(const function_type& function) noexcept;
+
+    void operator()(T* instance) const;
+
+private:
+    const function_type* function_;
+
+};
+
+/**
+ * @brief A unique instance of T released with the deleter registered with its definition.
+ * @details
+ * Unlike **std::unique_ptr<T>** obtained with **activate_unique**, which deletes instances with **delete**,
+ * instances allocated from pools, arenas or custom allocators by their factories can be handed out with
+ * **activate_unique_ref**. For instance:
+ * @code
+ * builder.define_default<message>(
+ *      [&pool]() -> message* { return pool.acquire(); },
+ *      [&pool](message* instance) { pool.release(instance); });
+ *
+ * di::unique_ref<message> instance = activator.activate_default_unique_ref<message>();
+ * @endcode
+ *
+ * @tparam T Activated type.
+ */
+template <typename T>
+using unique_ref = std::unique_ptr<T, deleter<T>>;
+
+}
+
+#include "unique_ref.ipp"
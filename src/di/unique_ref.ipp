@@ -0,0 +1,33 @@
+#pragma once
+
+#include "unique_ref.hpp"
+
+
+namespace di {
+
+template <typename T>
+inline deleter<T>::deleter() noexcept
+    :
+        function_(nullptr)
+{
+
+}
+
+template <typename T>
+inline deleter<T>::deleter(const function_type& function) noexcept
+    :
+        function_(&function)
+{
+
+}
+
+template <typename T>
+inline void deleter<T>::operator()(T* instance) const
+{
+    if (function_ && *function_)
+        (*function_)(instance);
+    else
+        delete instance;
+}
+
+}
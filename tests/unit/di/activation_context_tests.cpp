@@ -7,7 +7,9 @@
 #include <boost/optional.hpp>
 
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 
 using namespace std;
 using namespace di;
@@ -184,6 +186,26 @@ TEST(activation_context, with_annotation)
             .with_annotation(string(sample_id));
 }
 
+TEST(activation_context, with_annotation_shared)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([](const activation_context& context) -> TestObject_1
+    {
+        EXPECT_TRUE(context.has_annotation<string>());
+        EXPECT_EQ(context.parent()->id(), test_context);
+
+        return { context.annotation<string>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    activation_context context(test_context, activator);
+
+    shared_ptr<TestObject_1> instance = context
+            .activate_default<TestObject_1>()
+            .with_annotation(string(sample_id));
+    ASSERT_EQ(instance->field1_, sample_id);
+}
+
 TEST(activation_context, with_optional_annotation)
 {
     definition_builder builder;
@@ -268,3 +290,79 @@ TEST(instance_activator, activate_default_with_description_with_single_parameter
 
     ASSERT_EQ(instance.field1_, parameter);
 }
+
+TEST(activation_context, activate_all)
+{
+    struct TestObject_2
+    {
+        int field1_;
+    };
+
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define_default<TestObject_2>([]() -> TestObject_2
+    {
+        return { 2 };
+    });
+
+    instance_activator activator(std::move(builder));
+    activation_context context(test_context, activator);
+
+    auto activated = context.activate_all<TestObject_1, TestObject_2, TestObject_1>(sample_id, "", sample_id);
+    ASSERT_EQ(get<0>(activated)->field1_, sample_id);
+    ASSERT_EQ(get<1>(activated)->field1_, 2);
+    ASSERT_EQ(get<2>(activated)->field1_, sample_id);
+    ASSERT_NE(get<0>(activated), get<2>(activated));
+}
+
+TEST(activation_context, activate_default_all_from_factory)
+{
+    struct TestObject_2
+    {
+        int field1_;
+    };
+
+    struct TestObject_3
+    {
+        unique_ptr<TestObject_1> first_;
+        unique_ptr<TestObject_2> second_;
+    };
+
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define_default<TestObject_2>([]() -> TestObject_2
+    {
+        return { 2 };
+    });
+    builder.define_default<TestObject_3>([](const activation_context& context) -> TestObject_3
+    {
+        auto dependencies = context.activate_default_all<TestObject_1, TestObject_2>();
+        return { std::move(get<0>(dependencies)), std::move(get<1>(dependencies)) };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_unique<TestObject_3>();
+    ASSERT_EQ(instance->first_->field1_, sample_id);
+    ASSERT_EQ(instance->second_->field1_, 2);
+}
+
+TEST(activation_context, activate_all_failure)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        throw runtime_error("unavailable");
+    });
+
+    instance_activator activator(std::move(builder));
+    activation_context context(test_context, activator);
+
+    ASSERT_THROW((context.activate_default_all<TestObject_1, TestObject_1>()), runtime_error);
+    ASSERT_THROW((context.activate_all<TestObject_1>("missing")), invalid_argument);
+}
@@ -0,0 +1,127 @@
+#include <di/activation_statistics.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace testing;
+using namespace di;
+
+
+TEST(activation_statistics, create)
+{
+    activation_statistics statistics;
+
+    auto snapshot = statistics.snapshot();
+    ASSERT_EQ(snapshot.activations, 0u);
+    ASSERT_EQ(snapshot.failures, 0u);
+    ASSERT_EQ(snapshot.creation_time, nanoseconds::zero());
+    ASSERT_EQ(snapshot.max_creation_time, nanoseconds::zero());
+    ASSERT_EQ(snapshot.live_instances, 0u);
+    ASSERT_EQ(snapshot.live_bytes, 0u);
+    ASSERT_EQ(statistics.mean_creation_time(), nanoseconds::zero());
+}
+
+TEST(activation_statistics, record)
+{
+    activation_statistics statistics;
+    statistics.record(nanoseconds(10));
+    statistics.record(nanoseconds(30));
+    statistics.record_failure();
+    statistics.record_acquire(16u);
+    statistics.record_acquire(16u);
+    statistics.record_release(16u);
+
+    auto snapshot = statistics.snapshot();
+    ASSERT_EQ(snapshot.activations, 2u);
+    ASSERT_EQ(snapshot.failures, 1u);
+    ASSERT_EQ(snapshot.creation_time, nanoseconds(40));
+    ASSERT_EQ(snapshot.max_creation_time, nanoseconds(30));
+    ASSERT_EQ(snapshot.live_instances, 1u);
+    ASSERT_EQ(snapshot.live_bytes, 16u);
+    ASSERT_EQ(statistics.mean_creation_time(), nanoseconds(20));
+}
+
+TEST(activation_statistics, record_concurrently)
+{
+    const auto threads_count = 8u;
+    const auto records_count = 10000u;
+
+    activation_statistics statistics;
+
+    vector<thread> threads;
+    for (auto i = 0u; i < threads_count; i++)
+        threads.emplace_back([&statistics, i, records_count]()
+        {
+            for (auto j = 0u; j < records_count; j++)
+            {
+                statistics.record(nanoseconds(i + 1u));
+                statistics.record_acquire(8u);
+                statistics.record_release(8u);
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto snapshot = statistics.snapshot();
+    ASSERT_EQ(snapshot.activations, threads_count * records_count);
+    ASSERT_EQ(snapshot.creation_time, nanoseconds(records_count * threads_count * (threads_count + 1u) / 2u));
+    ASSERT_EQ(snapshot.max_creation_time, nanoseconds(threads_count));
+    ASSERT_EQ(snapshot.live_instances, 0u);
+    ASSERT_EQ(snapshot.live_bytes, 0u);
+}
+
+TEST(activation_statistics, release_on_other_thread)
+{
+    activation_statistics statistics;
+
+    thread acquiring([&statistics]()
+    {
+        statistics.record_acquire(24u);
+        statistics.record_acquire(24u);
+    });
+    acquiring.join();
+
+    thread releasing([&statistics]()
+    {
+        statistics.record_release(24u);
+    });
+    releasing.join();
+
+    ASSERT_EQ(statistics.live_instances(), 1u);
+    ASSERT_EQ(statistics.live_bytes(), 24u);
+}
+
+TEST(activation_statistics, record_dependency_concurrently)
+{
+    activation_statistics statistics;
+
+    int storage[24];
+    vector<const definition*> dependencies;
+    for (auto& dependency : storage)
+        dependencies.push_back(reinterpret_cast<const definition*>(&dependency));
+
+    vector<thread> threads;
+    for (auto i = 0u; i < 4u; i++)
+    {
+        threads.emplace_back([&statistics, &dependencies]()
+        {
+            for (auto repeat = 0u; repeat < 100u; repeat++)
+            {
+                for (auto dependency : dependencies)
+                    statistics.record_dependency(dependency);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_THAT(statistics.dependencies(), UnorderedElementsAreArray(dependencies));
+}
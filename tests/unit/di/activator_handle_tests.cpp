@@ -0,0 +1,137 @@
+#include <di/activator_handle.hpp>
+#include <di/annotations_map.hpp>
+#include <di/definition_builder.hpp>
+#include <di/instance_activator.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace testing;
+using namespace di;
+
+
+namespace {
+
+const auto sample_id = "sample-id";
+
+struct TestObject_1
+{
+    string field1_;
+};
+
+}
+
+TEST(activator_handle, resolve_activate_unique_no_parameters)
+{
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto handle = activator.resolve<TestObject_1>(sample_id);
+    ASSERT_EQ(handle.id(), sample_id);
+
+    auto instance = handle.activate_unique();
+    ASSERT_TRUE(instance);
+    ASSERT_EQ(instance->field1_, sample_id);
+}
+
+TEST(activator_handle, resolve_default_activate_with_parameters)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1, string>([](string parameter0) -> TestObject_1
+    {
+        return { parameter0 };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto handle = activator.resolve_default<TestObject_1, string>();
+
+    auto unique_instance = handle.activate_unique("a");
+    ASSERT_TRUE(unique_instance);
+    ASSERT_EQ(unique_instance->field1_, "a");
+
+    auto shared_instance = handle.activate_shared("b");
+    ASSERT_TRUE(shared_instance);
+    ASSERT_EQ(shared_instance->field1_, "b");
+
+    auto raii_instance = handle.activate_raii("c");
+    ASSERT_EQ(raii_instance.field1_, "c");
+}
+
+TEST(activator_handle, resolve_missing)
+{
+    definition_builder builder;
+    instance_activator activator(std::move(builder));
+
+    ASSERT_THROW(activator.resolve<TestObject_1>(sample_id), invalid_argument);
+    ASSERT_THROW(activator.resolve_default<TestObject_1>(), invalid_argument);
+}
+
+TEST(activator_handle, copy_activates_same_definition)
+{
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto handle = activator.resolve<TestObject_1>(sample_id);
+    auto copy = handle;
+
+    auto instance = copy.activate_raii();
+    ASSERT_EQ(instance.field1_, sample_id);
+}
+
+TEST(activator_handle, activate_intercepted_and_decorated)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    vector<string> intercepted;
+    builder.define_interceptor<TestObject_1>([&intercepted](TestObject_1& instance, const activation_context& context)
+    {
+        intercepted.push_back(instance.field1_);
+    });
+    string decoration("-decorated");
+    builder.define_decorator<TestObject_1>([&decoration](TestObject_1&& undecorated) -> TestObject_1
+    {
+        return { undecorated.field1_ + decoration };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto handle = activator.resolve_default<TestObject_1>();
+
+    auto instance_1 = handle.activate_unique();
+    auto instance_2 = handle.activate_raii();
+
+    ASSERT_EQ(instance_1->field1_, string(sample_id) + "-decorated");
+    ASSERT_EQ(instance_2.field1_, string(sample_id) + "-decorated");
+    ASSERT_THAT(intercepted, ElementsAre(sample_id, sample_id));
+}
+
+TEST(activator_handle, activate_with_annotations)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([](const activation_context& context) -> TestObject_1
+    {
+        return { context.annotation<string>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto handle = activator.resolve_default<TestObject_1>();
+
+    auto instance = handle.activate_unique(annotations_map(string(sample_id)));
+    ASSERT_EQ(instance->field1_, sample_id);
+}
@@ -20,6 +20,24 @@ TEST(annotations_map, create_from_list)
     ASSERT_TRUE(annotations.contains<string>());
 }
 
+TEST(annotations_map, copy_and_move)
+{
+    annotations_map annotations(1, string("abc"));
+    const annotations_map& const_annotations = annotations;
+
+    annotations_map copied(annotations);
+    annotations_map const_copied(const_annotations);
+    annotations_map const_moved(std::move(const_annotations));
+    annotations_map moved(std::move(annotations));
+
+    for (auto& result : { &copied, &const_copied, &const_moved, &moved })
+    {
+        ASSERT_FALSE(result->contains<annotations_map>());
+        ASSERT_EQ(result->get<int>(), 1);
+        ASSERT_EQ(result->get<string>(), "abc");
+    }
+}
+
 TEST(annotations_map, set_reference)
 {
     auto annotation_1 = string("abc");
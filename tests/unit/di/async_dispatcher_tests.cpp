@@ -0,0 +1,128 @@
+#include <di/async_dispatcher.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace testing;
+using namespace di;
+
+
+TEST(async_dispatcher, create)
+{
+    async_dispatcher dispatcher;
+    ASSERT_EQ(dispatcher.dropped(), 0u);
+}
+
+TEST(async_dispatcher, post_delivers_in_order)
+{
+    string id_1("a");
+    string id_2("b");
+
+    vector<string> delivered;
+    async_dispatcher::handler_type handler = [&delivered](const interception_event& event)
+    {
+        ASSERT_EQ(event.type, typeid(int));
+        delivered.push_back(event.id);
+    };
+
+    async_dispatcher dispatcher(8u);
+    ASSERT_TRUE(dispatcher.post(handler, id_1, typeid(int)));
+    ASSERT_TRUE(dispatcher.post(handler, id_2, typeid(int)));
+    ASSERT_TRUE(dispatcher.post(handler, id_1, typeid(int)));
+
+    dispatcher.flush();
+    ASSERT_THAT(delivered, ElementsAre(id_1, id_2, id_1));
+}
+
+TEST(async_dispatcher, post_drops_when_full)
+{
+    string id("a");
+
+    atomic<bool> entered(false);
+    atomic<bool> released(false);
+    atomic<int> delivered(0);
+    async_dispatcher::handler_type handler = [&](const interception_event& event)
+    {
+        entered = true;
+        while (!released)
+            this_thread::yield();
+
+        delivered++;
+    };
+
+    async_dispatcher dispatcher(2u);
+    ASSERT_TRUE(dispatcher.post(handler, id, typeid(int)));
+    while (!entered)
+        this_thread::yield();
+
+    ASSERT_TRUE(dispatcher.post(handler, id, typeid(int)));
+    ASSERT_TRUE(dispatcher.post(handler, id, typeid(int)));
+    ASSERT_FALSE(dispatcher.post(handler, id, typeid(int)));
+    ASSERT_EQ(dispatcher.dropped(), 1u);
+
+    released = true;
+    dispatcher.flush();
+    ASSERT_EQ(delivered, 3);
+}
+
+TEST(async_dispatcher, post_concurrently)
+{
+    string id("a");
+
+    auto delivered = 0u;
+    async_dispatcher::handler_type handler = [&delivered](const interception_event& event)
+    {
+        delivered++;
+    };
+
+    const auto threads_count = 4u;
+    const auto posts_count = 1000u;
+    {
+        async_dispatcher dispatcher(threads_count * posts_count);
+
+        vector<thread> threads;
+        for (auto i = 0u; i < threads_count; i++)
+        {
+            threads.emplace_back([&]()
+            {
+                for (auto j = 0u; j < posts_count; j++)
+                    dispatcher.post(handler, id, typeid(int));
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        ASSERT_EQ(dispatcher.dropped(), 0u);
+    }
+
+    ASSERT_EQ(delivered, threads_count * posts_count);
+}
+
+TEST(async_dispatcher, handler_exception_ignored)
+{
+    string id("a");
+
+    auto delivered = 0;
+    async_dispatcher::handler_type failing = [](const interception_event& event)
+    {
+        throw runtime_error("failed");
+    };
+    async_dispatcher::handler_type handler = [&delivered](const interception_event& event)
+    {
+        delivered++;
+    };
+
+    async_dispatcher dispatcher;
+    dispatcher.post(failing, id, typeid(int));
+    dispatcher.post(handler, id, typeid(int));
+
+    dispatcher.flush();
+    ASSERT_EQ(delivered, 1);
+}
@@ -1647,4 +1647,44 @@ TEST(definition_builder,  define_decorator__rvalue__non_static_method__no_contex
 
     decorator_factory factory;
     builder.define_decorator(&decorator_factory::define, &factory);
-}
\ No newline at end of file
+}
+
+TEST(definition_builder, define_single_instance)
+{
+    definition_builder builder;
+    auto registration = builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    registration.single_instance();
+
+    definition& definition = registration;
+    ASSERT_FALSE(definition.initializer());
+}
+
+TEST(definition_builder, define_eager)
+{
+    definition_builder builder;
+    auto registration = builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    registration.eager();
+
+    definition& definition = registration;
+    ASSERT_TRUE(definition.initializer());
+}
+
+TEST(definition_builder, define_type)
+{
+    definition_builder builder;
+    auto registration = builder.define_type<TestObject_1>(sample_id);
+
+    ASSERT_EQ(registration.id(), sample_id);
+
+    definition& definition = registration;
+    auto creator = definition.creator<TestObject_1>();
+    ASSERT_TRUE(creator);
+
+    ASSERT_THROW(builder.define_type<TestObject_1>(sample_id), invalid_argument);
+}
@@ -0,0 +1,105 @@
+#include <di/factory.hpp>
+#include <di/definition_builder.hpp>
+#include <di/instance_activator.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace testing;
+using namespace di;
+
+
+namespace {
+
+const auto sample_id = "sample-id";
+
+struct worker
+{
+    int shard_;
+};
+
+struct engine
+{
+    explicit engine(factory<worker(int)>&& worker_factory)
+        : worker_factory_(std::move(worker_factory))
+    {
+
+    }
+
+    factory<worker(int)> worker_factory_;
+};
+
+}
+
+TEST(factory, activate_from_activator)
+{
+    definition_builder builder;
+    builder.define<worker, int>(sample_id, [](int shard) -> worker
+    {
+        return { shard };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto worker_factory = activator.activate_factory<worker, int>(sample_id);
+
+    auto unique_instance = worker_factory(1);
+    ASSERT_TRUE(unique_instance);
+    ASSERT_EQ(unique_instance->shard_, 1);
+
+    auto shared_instance = worker_factory.activate_shared(2);
+    ASSERT_TRUE(shared_instance);
+    ASSERT_EQ(shared_instance->shard_, 2);
+
+    auto raii_instance = worker_factory.activate_raii(3);
+    ASSERT_EQ(raii_instance.shard_, 3);
+}
+
+TEST(factory, inject_into_component)
+{
+    definition_builder builder;
+    builder.define_default<worker, int>([](int shard) -> worker
+    {
+        return { shard };
+    });
+    builder.define_default<engine>([](const activation_context& context) -> engine
+    {
+        return engine(context.activate_default_factory<worker, int>());
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_unique<engine>();
+
+    vector<int> shards;
+    for (auto shard = 0; shard < 3; shard++)
+        shards.push_back(instance->worker_factory_(shard)->shard_);
+
+    ASSERT_THAT(shards, ElementsAre(0, 1, 2));
+}
+
+TEST(factory, activate_with_annotations)
+{
+    definition_builder builder;
+    builder.define_default<worker>([](const activation_context& context) -> worker
+    {
+        return { context.annotation<int>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto worker_factory = activator.activate_default_factory<worker>();
+
+    auto instance = worker_factory.activate_unique(annotations_map(5));
+    ASSERT_EQ(instance->shard_, 5);
+}
+
+TEST(factory, activate_missing_definition)
+{
+    definition_builder builder;
+    instance_activator activator(std::move(builder));
+
+    ASSERT_THROW(activator.activate_default_factory<worker>(), invalid_argument);
+}
@@ -0,0 +1,129 @@
+#include <di/injector.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using namespace std;
+using namespace di;
+
+
+namespace {
+
+struct ticker
+{
+    int ticks_ = 42;
+};
+
+struct storage_interface
+{
+    virtual ~storage_interface() = default;
+    virtual string name() const = 0;
+};
+
+struct file_storage : storage_interface
+{
+    explicit file_storage(ticker ticker)
+        : ticks_(ticker.ticks_)
+    {
+    }
+
+    string name() const override
+    {
+        return "file";
+    }
+
+    int ticks_;
+};
+
+struct memory_storage : storage_interface
+{
+    string name() const override
+    {
+        return "memory";
+    }
+};
+
+struct settings
+{
+    ticker ticker_;
+    int retries_;
+};
+
+class engine
+{
+public:
+    engine(ticker ticker, const settings& settings, unique_ptr<storage_interface> storage, shared_ptr<storage_interface> shared)
+        :
+            ticks_(ticker.ticks_),
+            retries_(settings.retries_),
+            storage_(std::move(storage)),
+            shared_(std::move(shared))
+    {
+    }
+
+    int ticks_;
+    int retries_;
+    unique_ptr<storage_interface> storage_;
+    shared_ptr<storage_interface> shared_;
+};
+
+}
+
+TEST(injector, create_value)
+{
+    injector<> container;
+
+    auto instance = container.create<ticker>();
+    ASSERT_EQ(instance.ticks_, 42);
+}
+
+TEST(injector, create_aggregate)
+{
+    injector<> container;
+
+    auto instance = container.create<settings>();
+    ASSERT_EQ(instance.ticker_.ticks_, 42);
+    ASSERT_EQ(instance.retries_, 0);
+}
+
+TEST(injector, create_bound_interface)
+{
+    injector<binding<storage_interface, file_storage>> container;
+
+    auto unique_instance = container.create<unique_ptr<storage_interface>>();
+    ASSERT_EQ(unique_instance->name(), "file");
+    ASSERT_EQ(dynamic_cast<file_storage&>(*unique_instance).ticks_, 42);
+
+    auto shared_instance = container.create<shared_ptr<storage_interface>>();
+    ASSERT_EQ(shared_instance->name(), "file");
+}
+
+TEST(injector, create_graph)
+{
+    using storage_module = module<binding<storage_interface, memory_storage>>;
+
+    injector<module<storage_module>> container;
+
+    auto instance = container.create<engine>();
+    ASSERT_EQ(instance.ticks_, 42);
+    ASSERT_EQ(instance.retries_, 0);
+    ASSERT_EQ(instance.storage_->name(), "memory");
+    ASSERT_EQ(instance.shared_->name(), "memory");
+    ASSERT_NE(instance.storage_.get(), instance.shared_.get());
+}
+
+TEST(injector, implementation_of)
+{
+    using storage_module = module<binding<storage_interface, memory_storage>>;
+
+    static_assert(
+            is_same<implementation_of<storage_interface, binding<ticker>, storage_module>::implementation, memory_storage>::value,
+            "storage should be resolved from module");
+    static_assert(
+            is_same<implementation_of<ticker, storage_module>::implementation, ticker>::value,
+            "unbound type should resolve to itself");
+}
@@ -2,14 +2,26 @@
 #include <di/annotations_map.hpp>
 #include <di/instance_activator.hpp>
 #include <di/definition_builder.hpp>
+#include <di/factory.hpp>
+#include <di/lazy.hpp>
 
 #include <di/tools/movable_function.hpp>
+#include <di/tools/thread_pool.hpp>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
 
 using namespace std;
 using namespace testing;
@@ -1479,6 +1491,218 @@ TEST(instance_activator, activate_through_base_type_alias_shared_ptr)
     ASSERT_EQ(instance->field1_, sample_id);
 }
 
+TEST(instance_activator, activate_through_second_base_type_alias_preserves_deleter)
+{
+    struct FirstBase
+    {
+        virtual ~FirstBase() = default;
+
+        int first_ = 1;
+    };
+
+    struct SecondBase
+    {
+        virtual ~SecondBase() = default;
+
+        int second_ = 2;
+    };
+
+    struct DerivedObject : FirstBase, SecondBase
+    { };
+
+    vector<DerivedObject*> created;
+    vector<DerivedObject*> released;
+
+    definition_builder builder;
+    builder.define_default<DerivedObject>(
+                    [&created]() -> DerivedObject*
+                    {
+                        created.push_back(new DerivedObject());
+                        return created.back();
+                    },
+                    [&released](DerivedObject* instance)
+                    {
+                        released.push_back(instance);
+                        delete instance;
+                    })
+            .as<SecondBase>();
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_default_unique_ref<SecondBase>();
+        ASSERT_EQ(instance->second_, 2);
+        ASSERT_EQ(instance.get(), static_cast<SecondBase*>(created.back()));
+    }
+
+    ASSERT_EQ(released, created);
+}
+
+TEST(instance_activator, activate_through_virtual_base_type_alias)
+{
+    struct BaseObject
+    {
+        virtual ~BaseObject() = default;
+
+        string field1_ = sample_id;
+    };
+
+    struct DerivedObject : virtual BaseObject
+    { };
+
+    auto released = 0;
+
+    definition_builder builder;
+    builder.define_default<DerivedObject>(
+                    []() -> DerivedObject*
+                    {
+                        return new DerivedObject();
+                    },
+                    [&released](DerivedObject* instance)
+                    {
+                        released++;
+                        delete instance;
+                    })
+            .as<BaseObject>();
+
+    instance_activator activator(std::move(builder));
+    activator.activate_default_shared<BaseObject>();
+
+    auto instance = activator.activate_default_shared<BaseObject>();
+    ASSERT_EQ(instance->field1_, sample_id);
+
+    instance.reset();
+    ASSERT_EQ(released, 2);
+}
+
+TEST(instance_activator, activate_through_wrapping_type_alias)
+{
+    using test_function = std::function<string()>;
+
+    struct component
+    {
+        string operator()() const
+        {
+            return field1_;
+        }
+
+        string field1_;
+    };
+
+    auto released = 0;
+    vector<string> intercepted;
+    vector<bool> nested;
+
+    definition_builder builder;
+    builder.define<component>(
+                    sample_id,
+                    []() -> component*
+                    {
+                        return new component { sample_id };
+                    },
+                    [&released](component* instance)
+                    {
+                        released++;
+                        delete instance;
+                    })
+            .as<test_function>();
+
+    builder.define_interceptor<component>([&](component& instance, const activation_context& context)
+    {
+        intercepted.push_back(context.id());
+        nested.push_back(context.parent().is_initialized());
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_unique<test_function>(sample_id);
+
+    ASSERT_TRUE(instance);
+    ASSERT_EQ((*instance)(), sample_id);
+    ASSERT_THAT(intercepted, ElementsAre(sample_id));
+    ASSERT_THAT(nested, ElementsAre(false));
+    ASSERT_EQ(released, 1);
+}
+
+struct allocation_counted_component
+{
+    static void* operator new(size_t size)
+    {
+        allocated++;
+        return ::operator new(size);
+    }
+
+    static void* operator new(size_t size, void* storage)
+    {
+        return storage;
+    }
+
+    static void operator delete(void* pointer)
+    {
+        ::operator delete(pointer);
+    }
+
+    string operator()() const
+    {
+        return field1_;
+    }
+
+    string field1_;
+
+    static int allocated;
+};
+
+int allocation_counted_component::allocated = 0;
+
+TEST(instance_activator, activate_through_wrapping_type_alias_by_value)
+{
+    struct named
+    {
+        named(allocation_counted_component&& component)
+            : name_(component())
+        {
+
+        }
+
+        string name_;
+    };
+
+    vector<string> intercepted;
+    vector<bool> nested;
+
+    definition_builder builder;
+    builder.define<allocation_counted_component>(sample_id, []() -> allocation_counted_component
+            {
+                return { "component" };
+            })
+            .as<named>();
+
+    builder.define_interceptor<allocation_counted_component>([&](
+            allocation_counted_component& instance,
+            const activation_context& context)
+    {
+        intercepted.push_back(context.id());
+        nested.push_back(context.parent().is_initialized());
+    });
+
+    function<allocation_counted_component(allocation_counted_component&&)> decorator =
+            [](allocation_counted_component&& undecorated) -> allocation_counted_component
+            {
+                return { undecorated.field1_ + "-decorated" };
+            };
+    builder.define_decorator<allocation_counted_component>(std::move(decorator));
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_unique<named>(sample_id);
+
+    ASSERT_TRUE(instance);
+    ASSERT_EQ(instance->name_, "component-decorated");
+    ASSERT_THAT(intercepted, ElementsAre(sample_id));
+    ASSERT_THAT(nested, ElementsAre(false));
+    ASSERT_EQ(allocation_counted_component::allocated, 0);
+
+    activator.activate_unique<allocation_counted_component>(sample_id);
+    ASSERT_EQ(allocation_counted_component::allocated, 1);
+}
+
 TEST(instance_activator, activate_with_annotations)
 {
     definition_builder builder;
@@ -1636,6 +1860,106 @@ TEST(instance_activator, activate__intercept_all_ids)
 
 }
 
+TEST(instance_activator, activate__intercept_for_id)
+{
+    string id_1("a");
+    string id_2("b");
+
+    definition_builder builder;
+    builder.define<TestObject_1>(id_1, [&]() -> TestObject_1
+    {
+        return { id_1 };
+    });
+
+    builder.define<TestObject_1>(id_2, [&]() -> TestObject_1
+    {
+        return { id_2 };
+    });
+
+    vector<string> intercepted;
+    builder.define_interceptor<TestObject_1>([&intercepted](const activation_context& context)
+    {
+        intercepted.push_back(context.id());
+    }).for_id(id_2);
+
+    instance_activator activator(std::move(builder));
+    activator.activate_raii<TestObject_1>(id_1);
+    activator.activate_raii<TestObject_1>(id_2);
+    ASSERT_THAT(intercepted, ElementsAre(id_2));
+}
+
+TEST(instance_activator, activate__intercept_when)
+{
+    struct is_remote
+    {
+        bool operator()(const string& id) const
+        {
+            return id.compare(0u, 7u, "remote.") == 0;
+        }
+    };
+
+    definition_builder builder;
+    for (auto id : { "local.a", "remote.a", "remote.b" })
+    {
+        builder.define<TestObject_1>(id, [id]() -> TestObject_1
+        {
+            return { id };
+        });
+    }
+
+    vector<string> intercepted;
+    builder.define_interceptor<TestObject_1>([&intercepted](TestObject_1& instance, const activation_context& context)
+    {
+        intercepted.push_back(instance.field1_);
+    }).when<is_remote>();
+
+    instance_activator activator(std::move(builder));
+    activator.activate_raii<TestObject_1>("local.a");
+    activator.activate_raii<TestObject_1>("remote.a");
+    activator.activate_raii<TestObject_1>("remote.b");
+    ASSERT_THAT(intercepted, ElementsAre("remote.a", "remote.b"));
+}
+
+TEST(instance_activator, activate__intercept_async)
+{
+    string id_1("a");
+    string id_2("b");
+
+    definition_builder builder;
+    builder.define<TestObject_1>(id_1, [&]() -> TestObject_1
+    {
+        return { id_1 };
+    });
+
+    builder.define<TestObject_1>(id_2, [&]() -> TestObject_1
+    {
+        return { id_2 };
+    });
+
+    vector<string> intercepted;
+    builder.define_async_interceptor<TestObject_1>([&intercepted](const interception_event& event)
+    {
+        ASSERT_EQ(event.type, typeid(TestObject_1));
+        intercepted.push_back(event.id);
+    });
+
+    vector<string> scoped;
+    builder.define_async_interceptor<TestObject_1>([&scoped](const interception_event& event)
+    {
+        scoped.push_back(event.id);
+    }).for_id(id_2);
+
+    instance_activator activator(std::move(builder));
+    activator.activate_raii<TestObject_1>(id_1);
+    activator.activate_unique<TestObject_1>(id_2);
+    activator.activate_shared<TestObject_1>(id_1);
+
+    activator.flush_interceptors();
+    ASSERT_THAT(intercepted, ElementsAre(id_1, id_2, id_1));
+    ASSERT_THAT(scoped, ElementsAre(id_2));
+    ASSERT_EQ(activator.dropped_interceptions(), 0u);
+}
+
 TEST(instance_activator, activate__intercept__non_static_method__no_intercepted_instance__no_context)
 {
     struct test_handler
@@ -2204,4 +2528,1529 @@ TEST(instance_activator, activate__decorate__resolvers_destroyed)
     ASSERT_EQ(component_count, 1u);
     ASSERT_EQ(decorator_count, 1u);
     ASSERT_EQ(decorator_created, decorator_deleted + 1u);
-}
\ No newline at end of file
+}
+
+TEST(instance_activator, activate__decorate__for_id)
+{
+    using test_function = std::function<string()>;
+
+    struct decorator
+    {
+        string operator()()
+        {
+            return "[" + undecorated_() + "]";
+        }
+
+        test_function undecorated_;
+    };
+
+    definition_builder builder;
+    builder.define<test_function>("a", []() -> test_function
+    {
+        return []() { return string("a"); };
+    });
+    builder.define<test_function>("b", []() -> test_function
+    {
+        return []() { return string("b"); };
+    });
+
+    builder.define_decorator<test_function>([](test_function&& undecorated) -> decorator
+    {
+        return { std::move(undecorated) };
+    }).for_id("b");
+
+    instance_activator activator(std::move(builder));
+    ASSERT_EQ(activator.activate_raii<test_function>("a")(), "a");
+    ASSERT_EQ(activator.activate_raii<test_function>("b")(), "[b]");
+}
+
+TEST(instance_activator, activate__decorate__when)
+{
+    using test_function = std::function<string()>;
+
+    struct is_remote
+    {
+        bool operator()(const string& id) const
+        {
+            return id.compare(0u, 7u, "remote.") == 0;
+        }
+    };
+
+    struct decorator
+    {
+        string operator()()
+        {
+            return "[" + undecorated_() + "]";
+        }
+
+        test_function undecorated_;
+    };
+
+    definition_builder builder;
+    for (auto id : { "local.a", "remote.a", "remote.b" })
+    {
+        builder.define<test_function>(id, [id]() -> test_function
+        {
+            return [id]() { return string(id); };
+        });
+    }
+
+    builder.define_decorator<test_function>([](test_function&& undecorated) -> decorator
+    {
+        return { std::move(undecorated) };
+    }).when<is_remote>();
+
+    instance_activator activator(std::move(builder));
+    ASSERT_EQ(activator.activate_raii<test_function>("local.a")(), "local.a");
+    ASSERT_EQ(activator.activate_raii<test_function>("remote.a")(), "[remote.a]");
+    ASSERT_EQ(activator.activate_raii<test_function>("remote.b")(), "[remote.b]");
+}
+
+TEST(instance_activator, activate__decorate__function_object__in_place)
+{
+    using test_function = movable_function<void()>;
+
+    static auto component_count = 0u;
+    static auto decorator_count = 0u;
+    static auto live_count = 0;
+
+    struct counted
+    {
+        counted() { live_count++; }
+        counted(const counted& other) { live_count++; }
+        ~counted() { live_count--; }
+    };
+
+    struct component
+    {
+        void operator()()
+        {
+            component_count++;
+        }
+
+        counted counted_;
+    };
+
+    struct decorator
+    {
+        decorator(test_function&& undecorated)
+                : undecorated_(std::move(undecorated))
+        {
+
+        }
+
+        void operator()()
+        {
+            decorator_count++;
+            undecorated_();
+        }
+
+        test_function undecorated_;
+        counted counted_;
+    };
+
+    definition_builder builder;
+    builder.define_default<test_function>([]() -> component
+    {
+        return component();
+    });
+
+    // decorator 1
+    builder.define_decorator<test_function>([](test_function&& undecorated) -> decorator
+    {
+        return decorator(std::move(undecorated));
+    });
+    // decorator 2
+    builder.define_decorator<test_function>([](test_function&& undecorated) -> decorator
+    {
+        return decorator(std::move(undecorated));
+    });
+
+    {
+        instance_activator activator(std::move(builder));
+        auto instance = activator.activate_default_unique<test_function>();
+
+        (*instance)();
+        ASSERT_EQ(component_count, 1u);
+        ASSERT_EQ(decorator_count, 2u);
+        ASSERT_EQ(live_count, 3);
+    }
+
+    ASSERT_EQ(live_count, 0);
+}
+
+TEST(instance_activator, activate__decorate__layered)
+{
+    static vector<string> calls;
+    static auto layers_count = 0;
+    static auto components_count = 0;
+
+    struct interface
+    {
+        virtual ~interface() = default;
+
+        virtual void method() = 0;
+    };
+
+    struct component : interface
+    {
+        component() { components_count++; }
+        ~component() { components_count--; }
+
+        void method() override
+        {
+            calls.push_back("component");
+        }
+    };
+
+    struct layer : interface
+    {
+        layer(interface& undecorated, const char* name)
+            :
+                undecorated_(undecorated),
+                name_(name)
+        {
+            layers_count++;
+        }
+
+        ~layer()
+        {
+            layers_count--;
+        }
+
+        void method() override
+        {
+            calls.push_back(name_);
+            undecorated_.method();
+        }
+
+        interface& undecorated_;
+        const char* name_;
+    };
+
+    struct layer_a : layer
+    {
+        explicit layer_a(interface& undecorated) : layer(undecorated, "a") { }
+    };
+
+    struct layer_b : layer
+    {
+        explicit layer_b(interface& undecorated) : layer(undecorated, "b") { }
+    };
+
+    struct layer_c : layer
+    {
+        explicit layer_c(interface& undecorated) : layer(undecorated, "c") { }
+    };
+
+    definition_builder builder;
+    builder.define_default<interface>([]() -> unique_ptr<interface>
+    {
+        return unique_ptr<interface>(new component());
+    });
+    builder.define_decorator<interface, layer_a>();
+    builder.define_decorator<interface, layer_b>();
+    builder.define_decorator<interface, layer_c>();
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_default_shared<interface>();
+        ASSERT_EQ(layers_count, 3);
+        ASSERT_EQ(components_count, 1);
+
+        instance->method();
+        ASSERT_THAT(calls, UnorderedElementsAre("a", "b", "c", "component"));
+        ASSERT_EQ(calls.back(), "component");
+    }
+
+    ASSERT_EQ(layers_count, 0);
+    ASSERT_EQ(components_count, 0);
+
+    ASSERT_THROW(activator.activate_default_unique<interface>(), logic_error);
+    ASSERT_THROW(activator.activate_default_factory<interface>()(), logic_error);
+    ASSERT_EQ(layers_count, 0);
+    ASSERT_EQ(components_count, 0);
+}
+
+TEST(instance_activator, activate__decorate__layered_and_pointer)
+{
+    static auto decorator_count = 0u;
+    static auto live_count = 0;
+
+    struct interface
+    {
+        virtual ~interface() = default;
+
+        virtual int method() = 0;
+    };
+
+    struct component : interface
+    {
+        component() { live_count++; }
+        ~component() { live_count--; }
+
+        int method() override
+        {
+            return 1;
+        }
+    };
+
+    struct layer : interface
+    {
+        explicit layer(interface& undecorated)
+            :
+                undecorated_(undecorated)
+        {
+            live_count++;
+        }
+
+        ~layer()
+        {
+            live_count--;
+        }
+
+        int method() override
+        {
+            return undecorated_.method() * 10;
+        }
+
+        interface& undecorated_;
+    };
+
+    struct decorator : interface
+    {
+        decorator(unique_ptr<interface>&& undecorated)
+            :
+                undecorated_(std::move(undecorated))
+        {
+            live_count++;
+        }
+
+        ~decorator()
+        {
+            live_count--;
+        }
+
+        int method() override
+        {
+            decorator_count++;
+            return undecorated_->method() + 1;
+        }
+
+        unique_ptr<interface> undecorated_;
+    };
+
+    definition_builder builder;
+    builder.define_default<interface>([]() -> unique_ptr<interface>
+    {
+        return unique_ptr<interface>(new component());
+    });
+    builder.define_decorator<interface, layer>();
+    builder.define_decorator<interface>([](unique_ptr<interface>&& undecorated) -> unique_ptr<interface>
+    {
+        return unique_ptr<interface>(new decorator(std::move(undecorated)));
+    });
+    builder.define_decorator<interface, layer>();
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_default_unique_ref<interface>();
+        ASSERT_EQ(live_count, 4);
+        ASSERT_EQ(instance->method(), 200);
+        ASSERT_EQ(decorator_count, 1u);
+    }
+
+    ASSERT_EQ(live_count, 0);
+}
+
+TEST(instance_activator, activate_many)
+{
+    auto created = 0;
+
+    definition_builder builder;
+    builder.define<TestObject_1, string>(sample_id, [&created](string parameter0) -> TestObject_1
+    {
+        created++;
+        return { parameter0 };
+    });
+
+    vector<string> intercepted;
+    builder.define_interceptor<TestObject_1, string>([&intercepted](const activation_context& context, string parameter0)
+    {
+        intercepted.push_back(parameter0);
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instances = activator.activate_many<TestObject_1, string>(sample_id, 3u, "abc");
+
+    ASSERT_EQ(created, 3);
+    ASSERT_EQ(instances.size(), 3u);
+    for (auto& instance : instances)
+    {
+        ASSERT_TRUE(instance);
+        ASSERT_EQ(instance->field1_, "abc");
+    }
+    ASSERT_THAT(intercepted, ElementsAre("abc", "abc", "abc"));
+}
+
+TEST(instance_activator, activate_many_into_buffer_default)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    instance_activator activator(std::move(builder));
+
+    unique_ptr<TestObject_1> instances[4];
+    activator.activate_default_many<TestObject_1>(instances, 4u);
+
+    for (auto& instance : instances)
+    {
+        ASSERT_TRUE(instance);
+        ASSERT_EQ(instance->field1_, sample_id);
+    }
+}
+
+TEST(instance_activator, activate_many_id_missing)
+{
+    definition_builder builder;
+    instance_activator activator(std::move(builder));
+
+    ASSERT_THROW(activator.activate_many<TestObject_1>(sample_id, 2u), invalid_argument);
+    ASSERT_THROW(activator.activate_default_many<TestObject_1>(2u), invalid_argument);
+}
+
+TEST(instance_activator, activate_shared_single_instance)
+{
+    auto created = 0;
+
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, [&created]() -> TestObject_1
+            {
+                created++;
+                return { sample_id };
+            })
+            .single_instance();
+
+    instance_activator activator(std::move(builder));
+    ASSERT_EQ(created, 0);
+
+    auto instance_1 = activator.activate_shared<TestObject_1>(sample_id);
+    auto instance_2 = activator.activate_shared<TestObject_1>(sample_id);
+    ASSERT_EQ(created, 1);
+    ASSERT_EQ(instance_1, instance_2);
+
+    auto unique_instance = activator.activate_unique<TestObject_1>(sample_id);
+    ASSERT_EQ(created, 2);
+    ASSERT_NE(unique_instance.get(), instance_1.get());
+}
+
+TEST(instance_activator, activate_shared_memoized)
+{
+    auto created = 0;
+
+    definition_builder builder;
+    builder.define<TestObject_1, string>(sample_id, [&created](string symbol) -> TestObject_1
+            {
+                created++;
+                return { symbol };
+            })
+            .memoized(2u, 1u);
+
+    instance_activator activator(std::move(builder));
+
+    auto instance_1 = activator.activate_shared<TestObject_1, string>(sample_id, "a");
+    auto instance_2 = activator.activate_shared<TestObject_1, string>(sample_id, "a");
+    auto instance_3 = activator.activate_shared<TestObject_1, string>(sample_id, "b");
+    ASSERT_EQ(created, 2);
+    ASSERT_EQ(instance_1, instance_2);
+    ASSERT_EQ(instance_3->field1_, "b");
+
+    activator.activate_shared<TestObject_1, string>(sample_id, "c");
+    ASSERT_EQ(created, 3);
+    auto instance_4 = activator.activate_shared<TestObject_1, string>(sample_id, "a");
+    ASSERT_NE(instance_4, instance_1);
+    ASSERT_EQ(created, 4);
+
+    activator.activate_unique<TestObject_1, string>(sample_id, "c");
+    ASSERT_EQ(created, 5);
+}
+
+TEST(instance_activator, activate_shared_weak_instance)
+{
+    auto created = 0;
+
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, [&created]() -> TestObject_1
+            {
+                created++;
+                return { sample_id };
+            })
+            .weak_instance();
+
+    instance_activator activator(std::move(builder));
+
+    auto instance_1 = activator.activate_shared<TestObject_1>(sample_id);
+    auto instance_2 = activator.activate_shared<TestObject_1>(sample_id);
+    ASSERT_EQ(created, 1);
+    ASSERT_EQ(instance_1, instance_2);
+
+    instance_1.reset();
+    instance_2.reset();
+    activator.activate_shared<TestObject_1>(sample_id);
+    ASSERT_EQ(created, 2);
+}
+
+TEST(instance_activator, activate_shared_per_cpu)
+{
+    struct counter
+    {
+        atomic<int> value_ { 0 };
+    };
+
+    definition_builder builder;
+    builder.define<counter>(sample_id, []() -> unique_ptr<counter>
+            {
+                return unique_ptr<counter>(new counter());
+            })
+            .per_cpu(2u);
+
+    instance_activator activator(std::move(builder));
+
+    auto instance_1 = activator.activate_shared<counter>(sample_id);
+    auto instance_2 = activator.activate_shared<counter>(sample_id);
+    instance_1->value_++;
+    instance_2->value_++;
+
+    auto shards = activator.activate_raii<per_cpu_shards<counter>>(sample_id);
+    ASSERT_EQ(shards.size(), 2u);
+
+    auto total = 0;
+    for (auto& instance : shards.instances())
+        total += instance->value_;
+    ASSERT_EQ(total, 2);
+}
+
+TEST(instance_activator, activate_eager_on_construction)
+{
+    struct connection_pool
+    {
+        string name_;
+    };
+
+    struct cache
+    {
+        shared_ptr<connection_pool> pool_;
+    };
+
+    atomic<int> pools_created(0);
+    atomic<int> caches_created(0);
+
+    definition_builder builder;
+    builder.define_default<connection_pool>([&pools_created]() -> connection_pool
+            {
+                pools_created++;
+                this_thread::sleep_for(chrono::milliseconds(10));
+                return { sample_id };
+            })
+            .eager();
+    for (auto id : { "a", "b", "c", "d" })
+    {
+        builder.define<cache>(id, [&caches_created](const activation_context& context) -> cache
+                {
+                    caches_created++;
+                    return { context.activate_default_shared<connection_pool>() };
+                })
+                .eager();
+    }
+
+    instance_activator activator(std::move(builder));
+    ASSERT_EQ(pools_created, 1);
+    ASSERT_EQ(caches_created, 4);
+
+    auto cache_a = activator.activate_shared<cache>("a");
+    auto cache_d = activator.activate_shared<cache>("d");
+    ASSERT_EQ(caches_created, 4);
+    ASSERT_EQ(cache_a->pool_, cache_d->pool_);
+    ASSERT_EQ(cache_a->pool_, activator.activate_default_shared<connection_pool>());
+}
+
+TEST(instance_activator, activate_eager_failure)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+            {
+                throw runtime_error("unavailable");
+            })
+            .eager();
+
+    ASSERT_THROW(instance_activator activator(std::move(builder)), runtime_error);
+}
+
+TEST(instance_activator, activate_async)
+{
+    definition_builder builder;
+    builder.define<TestObject_1, string>(sample_id, [](string description) -> TestObject_1
+    {
+        return { description };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto pending = activator.activate_async<TestObject_1, string>(sample_id, "description");
+
+    auto instance = pending.get();
+    ASSERT_TRUE(instance);
+    ASSERT_EQ(instance->field1_, "description");
+}
+
+TEST(instance_activator, activate_async_id_missing)
+{
+    definition_builder builder;
+    instance_activator activator(std::move(builder));
+
+    ASSERT_THROW(activator.activate_default_async<TestObject_1>(), invalid_argument);
+}
+
+TEST(instance_activator, activate_async_graph)
+{
+    struct storage
+    {
+        string path_;
+    };
+
+    struct network
+    {
+        int port_;
+    };
+
+    struct engine
+    {
+        unique_ptr<storage> storage_;
+        unique_ptr<network> network_;
+    };
+
+    definition_builder builder;
+    builder.define_default_async<storage>([]() -> future<storage>
+    {
+        return async(launch::async, []() -> storage
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            return { "/tmp" };
+        });
+    });
+    builder.define_default_async<network, int>([](int port) -> future<network>
+    {
+        return async(launch::async, [port]() -> network
+        {
+            return { port };
+        });
+    });
+    builder.define_default<engine>([](const activation_context& context) -> engine
+    {
+        auto storage_pending = context.activate_default_async<storage>();
+        auto network_pending = context.activate_default_async<network, int>(8080);
+
+        return { context.wait(storage_pending), context.wait(network_pending) };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_async<engine>().get();
+    ASSERT_EQ(instance->storage_->path_, "/tmp");
+    ASSERT_EQ(instance->network_->port_, 8080);
+
+    auto storage_instance = activator.activate_default_unique<storage>();
+    ASSERT_EQ(storage_instance->path_, "/tmp");
+}
+
+TEST(instance_activator, activate_async_failure)
+{
+    definition_builder builder;
+    builder.define_default_async<TestObject_1>([]() -> future<TestObject_1>
+    {
+        return async(launch::deferred, []() -> TestObject_1
+        {
+            throw runtime_error("unavailable");
+        });
+    });
+
+    instance_activator activator(std::move(builder));
+    auto pending = activator.activate_default_async<TestObject_1>();
+
+    ASSERT_THROW(pending.get(), runtime_error);
+}
+
+TEST(instance_activator, activate_async_within_single_instance)
+{
+    struct source
+    {
+        string name_;
+    };
+
+    struct settings
+    {
+        string name_;
+    };
+
+    struct service
+    {
+        shared_ptr<settings> settings_;
+    };
+
+    definition_builder builder;
+    builder.define_default<source>([]() -> source
+    {
+        return { "settings" };
+    });
+    builder.define_default<settings>([](const activation_context& context) -> settings
+            {
+                auto pending = context.activate_default_async<source>();
+                return { context.wait(pending)->name_ };
+            })
+            .single_instance();
+    builder.define_default<service>([](const activation_context& context) -> service
+    {
+        return { context.activate_default_shared<settings>() };
+    });
+
+    instance_activator activator(std::move(builder));
+
+    // occupy all workers of the shared pool, pending activations can only be executed by waiting threads
+    auto& pool = tools::thread_pool::shared();
+    promise<void> release;
+    auto released = release.get_future().share();
+    atomic<size_t> blocked(0u);
+    vector<future<void>> blockers;
+    for (auto i = 0u; i < pool.concurrency(); i++)
+    {
+        blockers.push_back(pool.submit([released, &blocked]()
+        {
+            blocked++;
+            released.wait();
+        }));
+    }
+
+    while (blocked < pool.concurrency())
+        this_thread::yield();
+
+    // an unrelated activation needing the single instance is pending while the single instance waits for its source
+    packaged_task<pair<future<unique_ptr<service>>, shared_ptr<settings>>()> activate([&activator]()
+    {
+        auto unrelated = activator.activate_default_async<service>();
+        auto instance = activator.activate_default_shared<settings>();
+
+        return make_pair(std::move(unrelated), instance);
+    });
+    auto activated = activate.get_future();
+    thread(std::move(activate)).detach();
+
+    auto status = activated.wait_for(chrono::seconds(10));
+    release.set_value();
+    for (auto& blocker : blockers)
+        blocker.wait();
+
+    ASSERT_EQ(status, future_status::ready);
+
+    auto result = activated.get();
+    ASSERT_EQ(result.second->name_, "settings");
+    ASSERT_EQ(result.first.get()->settings_, result.second);
+}
+
+namespace {
+
+struct injected_storage
+{
+    virtual ~injected_storage() = default;
+    virtual string name() const = 0;
+};
+
+struct injected_file_storage : injected_storage
+{
+    string name() const override
+    {
+        return "file";
+    }
+};
+
+struct injected_settings
+{
+    TestObject_1 name_;
+    int retries_;
+};
+
+class injected_engine
+{
+public:
+    injected_engine(
+            const injected_settings& settings,
+            unique_ptr<injected_storage> storage,
+            shared_ptr<TestObject_1> shared,
+            lazy<TestObject_1> lazy_name,
+            factory<TestObject_1(string)> name_factory)
+        :
+            settings_(settings),
+            storage_(std::move(storage)),
+            shared_(std::move(shared)),
+            lazy_name_(std::move(lazy_name)),
+            name_factory_(std::move(name_factory))
+    {
+    }
+
+    injected_settings settings_;
+    unique_ptr<injected_storage> storage_;
+    shared_ptr<TestObject_1> shared_;
+    lazy<TestObject_1> lazy_name_;
+    factory<TestObject_1(string)> name_factory_;
+};
+
+class injected_declared
+{
+public:
+    using inject = di::inject<TestObject_1>;
+
+    explicit injected_declared(TestObject_1 name)
+        : name_(name.field1_)
+    {
+    }
+
+    explicit injected_declared(unique_ptr<TestObject_1> name)
+        : name_("unique " + name->field1_)
+    {
+    }
+
+    string name_;
+};
+
+}
+
+TEST(instance_activator, activate_define_type)
+{
+    auto activations = 0;
+
+    definition_builder builder;
+    builder.define_default<TestObject_1>([&activations]() -> TestObject_1
+    {
+        activations++;
+        return { sample_id };
+    });
+    builder.define_default<TestObject_1, string>([](string name) -> TestObject_1
+    {
+        return { name };
+    });
+    builder.define_default<injected_storage>([]() -> unique_ptr<injected_storage>
+    {
+        return make_unique<injected_file_storage>();
+    });
+    builder.define_type<injected_settings>();
+    builder.define_type<injected_engine>(sample_id);
+
+    instance_activator activator(std::move(builder));
+
+    auto instance = activator.activate_unique<injected_engine>(sample_id);
+    ASSERT_EQ(instance->settings_.name_.field1_, sample_id);
+    ASSERT_EQ(instance->settings_.retries_, 0);
+    ASSERT_EQ(instance->storage_->name(), "file");
+    ASSERT_EQ(instance->shared_->field1_, sample_id);
+    ASSERT_EQ(activations, 2);
+    ASSERT_FALSE(instance->lazy_name_.is_activated());
+    ASSERT_EQ(instance->lazy_name_->field1_, sample_id);
+    ASSERT_EQ(instance->name_factory_("produced")->field1_, "produced");
+
+    auto second = activator.activate_raii<injected_engine>(sample_id);
+    ASSERT_EQ(second.settings_.name_.field1_, sample_id);
+    ASSERT_EQ(activations, 5);
+}
+
+TEST(instance_activator, activate_define_type_declared)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define_type<injected_declared>();
+
+    instance_activator activator(std::move(builder));
+
+    auto instance = activator.activate_default_unique<injected_declared>();
+    ASSERT_EQ(instance->name_, sample_id);
+}
+
+TEST(instance_activator, activate_define_type_missing_dependency)
+{
+    definition_builder builder;
+    builder.define_type<injected_settings>();
+
+    instance_activator activator(std::move(builder));
+
+    ASSERT_THROW(activator.activate_default_unique<injected_settings>(), invalid_argument);
+}
+
+TEST(instance_activator, validate_declared_dependencies)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define_default<TestObject_1, string>([](string name) -> TestObject_1
+            {
+                return { name };
+            })
+            .depends_on<TestObject_1>()
+            .depends_lazily_on<TestObject_1, string>();
+
+    instance_activator activator(std::move(builder));
+    ASSERT_EQ(activator.activate_default_unique<TestObject_1>(string("name"))->field1_, "name");
+}
+
+TEST(instance_activator, validate_missing_dependency)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+            {
+                return { sample_id };
+            })
+            .depends_on<TestObject_1, string>()
+            .depends_on<TestObject_1>("missing-id");
+
+    try
+    {
+        instance_activator activator(std::move(builder));
+        FAIL();
+    }
+    catch (const invalid_argument& e)
+    {
+        string message(e.what());
+        ASSERT_THAT(message, HasSubstr("arguments mismatch: TestObject_1 '' requires TestObject_1(std::"));
+        ASSERT_THAT(message, HasSubstr("missing: TestObject_1 '' requires TestObject_1 'missing-id'"));
+    }
+}
+
+TEST(instance_activator, validate_cycle)
+{
+    struct TestObject_2
+    {
+    };
+
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+            {
+                return { sample_id };
+            })
+            .depends_on<TestObject_2>();
+    builder.define_default<TestObject_2>([]() -> TestObject_2
+            {
+                return {};
+            })
+            .depends_on<TestObject_1>(sample_id);
+
+    try
+    {
+        instance_activator activator(std::move(builder));
+        FAIL();
+    }
+    catch (const invalid_argument& e)
+    {
+        string message(e.what());
+        ASSERT_THAT(message, HasSubstr("cycle: "));
+        ASSERT_THAT(message, HasSubstr("TestObject_1 'sample-id' -> "));
+        ASSERT_THAT(message, HasSubstr("TestObject_2 '' -> "));
+    }
+}
+
+TEST(instance_activator, validate_deferred_cycle)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+            {
+                return { sample_id };
+            })
+            .depends_lazily_on<TestObject_1>();
+
+    instance_activator activator(std::move(builder));
+}
+
+TEST(instance_activator, validate_define_type_declared)
+{
+    definition_builder builder;
+    builder.define_type<injected_declared>();
+
+    ASSERT_THROW(instance_activator activator(std::move(builder)), invalid_argument);
+}
+
+TEST(instance_activator, export_graph)
+{
+    struct TestObject_2
+    {
+        TestObject_1 dependency_;
+    };
+
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define<TestObject_2, string>(sample_id, [](const activation_context& context, string) -> TestObject_2
+            {
+                return { context.activate_default_raii<TestObject_1>() };
+            })
+            .depends_lazily_on<TestObject_1>();
+    builder.define_interceptor<TestObject_1>([](TestObject_1& instance, const activation_context& context)
+    {
+    });
+
+    instance_activator activator(std::move(builder));
+    activator.set_statistics_enabled(true);
+    ASSERT_TRUE(activator.statistics_enabled());
+
+    activator.activate_unique<TestObject_2, string>(sample_id, "argument");
+    activator.activate_unique<TestObject_2, string>(sample_id, "argument");
+
+    stringstream dot;
+    activator.export_graph(dot, instance_activator::graph_format::dot);
+    ASSERT_THAT(dot.str(), StartsWith("digraph definitions {"));
+    ASSERT_THAT(dot.str(), HasSubstr("TestObject_2(std::"));
+    ASSERT_THAT(dot.str(), HasSubstr("id: 'sample-id'"));
+    ASSERT_THAT(dot.str(), HasSubstr("interceptors: 1, decorators: 0"));
+    ASSERT_THAT(dot.str(), HasSubstr("activations: 2"));
+    ASSERT_THAT(dot.str(), HasSubstr("[style=dashed];"));
+
+    stringstream json;
+    activator.export_graph(json, instance_activator::graph_format::json);
+    ASSERT_THAT(json.str(), HasSubstr("\"type\":\"TestObject_1\",\"arguments\":[],\"interceptors\":1"));
+    ASSERT_THAT(json.str(), HasSubstr("\"activations\":2"));
+    ASSERT_THAT(json.str(), HasSubstr("\"deferred\":true"));
+    ASSERT_THAT(json.str(), Not(HasSubstr("\"deferred\":false")));
+}
+
+TEST(instance_activator, export_graph_escape_id)
+{
+    definition_builder builder;
+    builder.define<TestObject_1>("line\n\"quoted\"\t\x01", []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    instance_activator activator(std::move(builder));
+
+    stringstream dot;
+    activator.export_graph(dot, instance_activator::graph_format::dot);
+    ASSERT_THAT(dot.str(), HasSubstr("id: 'line\\n\\\"quoted\\\"\\t\\u0001'"));
+
+    stringstream json;
+    activator.export_graph(json, instance_activator::graph_format::json);
+    ASSERT_THAT(json.str(), HasSubstr("\"id\":\"line\\n\\\"quoted\\\"\\t\\u0001\""));
+    ASSERT_THAT(json.str(), Not(HasSubstr("\x01")));
+}
+
+TEST(instance_activator, export_graph_statistics_disabled)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    instance_activator activator(std::move(builder));
+    activator.activate_default_unique<TestObject_1>();
+
+    stringstream json;
+    activator.export_graph(json, instance_activator::graph_format::json);
+    ASSERT_THAT(json.str(), HasSubstr("\"activations\":0"));
+    ASSERT_THAT(json.str(), HasSubstr("\"dependencies\":[]"));
+}
+
+namespace {
+
+struct recording_tracer : activation_tracer
+{
+    struct record
+    {
+        string event;
+        string id;
+        string type;
+        size_t depth;
+        bool failed;
+    };
+
+    void begin(const activation_event& event) override
+    {
+        records_.push_back({ "begin", event.id, demangle(event.type.name()), event.depth, event.failed });
+    }
+
+    void end(const activation_event& event) override
+    {
+        records_.push_back({ "end", event.id, demangle(event.type.name()), event.depth, event.failed });
+    }
+
+    vector<record> records_;
+};
+
+}
+
+TEST(instance_activator, trace_activations)
+{
+    struct TestObject_2
+    {
+        TestObject_1 dependency_;
+    };
+
+    definition_builder builder;
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define_default<TestObject_2>([](const activation_context& context) -> TestObject_2
+    {
+        return { context.activate_raii<TestObject_1>(sample_id) };
+    });
+
+    auto tracer = make_shared<recording_tracer>();
+
+    instance_activator activator(std::move(builder));
+    activator.set_tracer(tracer);
+    ASSERT_EQ(activator.tracer(), tracer);
+
+    activator.activate_default_unique<TestObject_2>();
+
+    auto& records = tracer->records_;
+    ASSERT_EQ(records.size(), 4u);
+    ASSERT_EQ(records[0].event, "begin");
+    ASSERT_EQ(records[0].id, "");
+    ASSERT_THAT(records[0].type, HasSubstr("TestObject_2"));
+    ASSERT_EQ(records[0].depth, 0u);
+    ASSERT_EQ(records[1].event, "begin");
+    ASSERT_EQ(records[1].id, sample_id);
+    ASSERT_EQ(records[1].type, "TestObject_1");
+    ASSERT_EQ(records[1].depth, 1u);
+    ASSERT_EQ(records[2].event, "end");
+    ASSERT_EQ(records[2].id, sample_id);
+    ASSERT_EQ(records[3].event, "end");
+    ASSERT_EQ(records[3].depth, 0u);
+    ASSERT_FALSE(records[3].failed);
+
+    activator.set_tracer(nullptr);
+    activator.activate_default_unique<TestObject_2>();
+    ASSERT_EQ(records.size(), 4u);
+}
+
+TEST(instance_activator, trace_activation_failure)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        throw runtime_error("failed");
+    });
+
+    auto tracer = make_shared<recording_tracer>();
+
+    instance_activator activator(std::move(builder));
+    activator.set_tracer(tracer);
+
+    ASSERT_THROW(activator.activate_default_unique<TestObject_1>(), runtime_error);
+
+    auto& records = tracer->records_;
+    ASSERT_EQ(records.size(), 2u);
+    ASSERT_EQ(records[1].event, "end");
+    ASSERT_TRUE(records[1].failed);
+}
+
+TEST(instance_activator, metrics)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        throw runtime_error("failed");
+    });
+
+    instance_activator activator(std::move(builder));
+    activator.set_statistics_enabled(true);
+
+    auto shared_instance = activator.activate_default_shared<TestObject_1>();
+    {
+        auto released_instance = activator.activate_default_shared<TestObject_1>();
+    }
+    activator.activate_default_unique<TestObject_1>();
+    ASSERT_THROW(activator.activate_unique<TestObject_1>(sample_id), runtime_error);
+
+    auto metrics = activator.metrics();
+    ASSERT_EQ(metrics.size(), 2u);
+
+    auto default_metrics = find_if(metrics.begin(), metrics.end(), [](const activation_metrics& entry)
+    {
+        return entry.id == definition::default_id;
+    });
+    ASSERT_NE(default_metrics, metrics.end());
+    ASSERT_EQ(default_metrics->type, type_index(typeid(TestObject_1)));
+    ASSERT_EQ(default_metrics->statistics.activations, 3u);
+    ASSERT_EQ(default_metrics->statistics.failures, 0u);
+    ASSERT_EQ(default_metrics->statistics.live_instances, 1u);
+    ASSERT_GE(default_metrics->statistics.creation_time, default_metrics->statistics.max_creation_time);
+
+    auto failing_metrics = find_if(metrics.begin(), metrics.end(), [](const activation_metrics& entry)
+    {
+        return entry.id == sample_id;
+    });
+    ASSERT_NE(failing_metrics, metrics.end());
+    ASSERT_EQ(failing_metrics->statistics.activations, 0u);
+    ASSERT_EQ(failing_metrics->statistics.failures, 1u);
+
+    shared_instance.reset();
+    ASSERT_EQ(activator.metrics()[0].statistics.live_instances, 0u);
+    ASSERT_EQ(activator.metrics()[1].statistics.live_instances, 0u);
+}
+
+TEST(instance_activator, report_live_instances)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    instance_activator activator(std::move(builder));
+    activator.set_instance_tracking_enabled(true);
+    ASSERT_TRUE(activator.instance_tracking_enabled());
+
+    auto first_instance = activator.activate_default_shared<TestObject_1>();
+    auto second_instance = activator.activate_default_shared<TestObject_1>();
+    {
+        auto released_instance = activator.activate_default_shared<TestObject_1>();
+    }
+
+    auto metrics = activator.metrics();
+    ASSERT_EQ(metrics.size(), 1u);
+    ASSERT_EQ(metrics[0].statistics.live_instances, 2u);
+    ASSERT_EQ(metrics[0].statistics.live_bytes, 2u * sizeof(TestObject_1));
+    ASSERT_EQ(metrics[0].statistics.activations, 0u);
+
+    stringstream report;
+    activator.report_live_instances(report);
+    ASSERT_THAT(report.str(), HasSubstr("  TestObject_1 '': 2 instances, " + to_string(2u * sizeof(TestObject_1)) + " bytes"));
+    ASSERT_THAT(report.str(), HasSubstr("total: 2 instances"));
+
+    second_instance.reset();
+    ASSERT_EQ(activator.metrics()[0].statistics.live_instances, 1u);
+}
+
+TEST(instance_activator, report_live_unique_ref_instances)
+{
+    auto released = 0;
+
+    definition_builder builder;
+    builder.define_default<TestObject_1>(
+            []() -> TestObject_1*
+            {
+                return new TestObject_1 { sample_id };
+            },
+            [&released](TestObject_1* instance)
+            {
+                released++;
+                delete instance;
+            });
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    function<TestObject_1(TestObject_1&&)> decorator = [](TestObject_1&& undecorated) -> TestObject_1
+    {
+        return { "[" + undecorated.field1_ + "]" };
+    };
+    builder.define_decorator<TestObject_1>(std::move(decorator)).for_id(sample_id);
+
+    instance_activator activator(std::move(builder));
+    activator.set_instance_tracking_enabled(true);
+
+    auto instance = activator.activate_default_unique_ref<TestObject_1>();
+    auto decorated_instance = activator.activate_unique_ref<TestObject_1>(sample_id);
+    auto unique_instance = activator.activate_default_unique<TestObject_1>();
+
+    auto live_instances = [&activator](const string& id)
+    {
+        for (auto& metrics : activator.metrics())
+        {
+            if (metrics.id == id)
+                return metrics.statistics.live_instances;
+        }
+
+        return uint64_t(0u);
+    };
+
+    ASSERT_EQ(decorated_instance->field1_, "[" + string(sample_id) + "]");
+    ASSERT_EQ(live_instances(definition::default_id), 1u);
+    ASSERT_EQ(live_instances(sample_id), 1u);
+
+    instance.reset();
+    ASSERT_EQ(released, 1);
+    ASSERT_EQ(live_instances(definition::default_id), 0u);
+
+    decorated_instance.reset();
+    ASSERT_EQ(live_instances(sample_id), 0u);
+}
+
+TEST(instance_activator, report_live_instances_at_shutdown)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+    builder.define<TestObject_1>(sample_id, []() -> TestObject_1
+    {
+        return { sample_id };
+    })
+    .single_instance();
+
+    stringstream report;
+    shared_ptr<TestObject_1> leaked_instance;
+    {
+        instance_activator activator(std::move(builder));
+        activator.set_instance_tracking_enabled(true, &report);
+
+        leaked_instance = activator.activate_default_shared<TestObject_1>();
+        activator.activate_shared<TestObject_1>(sample_id);
+    }
+
+    ASSERT_THAT(report.str(), HasSubstr("  TestObject_1 '': 1 instances"));
+    ASSERT_THAT(report.str(), Not(HasSubstr("sample-id")));
+    ASSERT_THAT(report.str(), HasSubstr("total: 1 instances"));
+}
+
+TEST(instance_activator, move_assign)
+{
+    auto make_builder = [](vector<string>& intercepted, const string& id)
+    {
+        definition_builder builder;
+        builder.define_default<TestObject_1>([id]() -> TestObject_1
+        {
+            return { id };
+        });
+        builder.define_async_interceptor<TestObject_1>([&intercepted, id](const interception_event& event)
+        {
+            this_thread::sleep_for(chrono::milliseconds(1));
+            intercepted.push_back(id);
+        });
+
+        return builder;
+    };
+
+    vector<string> replaced_intercepted;
+    vector<string> intercepted;
+
+    stringstream report;
+    shared_ptr<TestObject_1> leaked_instance;
+
+    instance_activator activator(make_builder(replaced_intercepted, "replaced"));
+    activator.set_instance_tracking_enabled(true, &report);
+    leaked_instance = activator.activate_default_shared<TestObject_1>();
+    for (auto i = 0; i < 10; i++)
+        activator.activate_default_raii<TestObject_1>();
+
+    activator = instance_activator(make_builder(intercepted, "assigned"));
+    ASSERT_EQ(replaced_intercepted.size(), 11u);
+    ASSERT_THAT(report.str(), HasSubstr("  TestObject_1 '': 1 instances"));
+
+    ASSERT_EQ(activator.activate_default_raii<TestObject_1>().field1_, "assigned");
+    activator.flush_interceptors();
+    ASSERT_THAT(intercepted, ElementsAre("assigned"));
+}
+
+TEST(instance_activator, report_live_instances_at_shutdown_none)
+{
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1
+    {
+        return { sample_id };
+    });
+
+    stringstream report;
+    {
+        instance_activator activator(std::move(builder));
+        activator.set_instance_tracking_enabled(true, &report);
+
+        activator.activate_default_shared<TestObject_1>();
+    }
+
+    ASSERT_TRUE(report.str().empty());
+}
+
+TEST(instance_activator, activate_unique_ref_preserves_deleter)
+{
+    static TestObject_1 pool[2];
+    static vector<TestObject_1*> released;
+    released.clear();
+
+    definition_builder builder;
+    builder.define<TestObject_1, int>(sample_id, [](int index) -> TestObject_1*
+    {
+        pool[index].field1_ = sample_id;
+        return &pool[index];
+    },
+    [](TestObject_1* instance)
+    {
+        released.push_back(instance);
+    });
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_unique_ref<TestObject_1, int>(sample_id, 1);
+        ASSERT_EQ(instance.get(), &pool[1]);
+        ASSERT_EQ(instance->field1_, sample_id);
+
+        auto handle = activator.resolve<TestObject_1, int>(sample_id);
+        auto handle_instance = handle.activate_unique_ref(0);
+        ASSERT_EQ(handle_instance.get(), &pool[0]);
+    }
+
+    ASSERT_THAT(released, UnorderedElementsAre(&pool[0], &pool[1]));
+}
+
+TEST(instance_activator, activate_unique_ref_from_context)
+{
+    struct TestObject_2
+    {
+        unique_ref<TestObject_1> dependency_;
+    };
+
+    static auto released = 0;
+
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1*
+    {
+        return new TestObject_1 { sample_id };
+    },
+    [](TestObject_1* instance)
+    {
+        released++;
+        delete instance;
+    });
+    builder.define_default<TestObject_2>([](const activation_context& context) -> TestObject_2
+    {
+        return { context.activate_default_unique_ref<TestObject_1>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_default_unique<TestObject_2>();
+        ASSERT_EQ(instance->dependency_->field1_, sample_id);
+    }
+
+    ASSERT_EQ(released, 1);
+}
+
+TEST(instance_activator, activate_unique_ref_decorated)
+{
+    static auto decorators_released = 0;
+
+    struct interface
+    {
+        virtual ~interface() = default;
+    };
+
+    struct component : interface
+    {
+    };
+
+    struct decorator : interface
+    {
+        explicit decorator(interface* undecorated)
+            : undecorated_(undecorated)
+        {
+        }
+
+        unique_ptr<interface> undecorated_;
+    };
+
+    definition_builder builder;
+    builder.define_default<interface>([]() -> interface*
+    {
+        return new component();
+    });
+    builder.define_decorator<interface>([](interface* undecorated) -> interface*
+    {
+        return new decorator(undecorated);
+    },
+    [](interface* decorated)
+    {
+        decorators_released++;
+        delete decorated;
+    });
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_default_unique_ref<interface>();
+        ASSERT_NE(dynamic_cast<decorator*>(instance.get()), nullptr);
+    }
+
+    ASSERT_EQ(decorators_released, 1);
+}
+
+TEST(instance_activator, activate_raii_releases_allocation)
+{
+    static auto live = 0;
+
+    struct counted
+    {
+        counted()
+        {
+            live++;
+        }
+
+        counted(counted&& other)
+        {
+            live++;
+        }
+
+        ~counted()
+        {
+            live--;
+        }
+    };
+
+    definition_builder builder;
+    builder.define_default<counted>([]() -> counted
+    {
+        return {};
+    });
+
+    instance_activator activator(std::move(builder));
+    {
+        auto instance = activator.activate_default_raii<counted>();
+        ASSERT_EQ(live, 1);
+    }
+
+    ASSERT_EQ(live, 0);
+}
+
+TEST(instance_activator, activate_shared_preserves_deleter)
+{
+    static auto released = 0;
+
+    definition_builder builder;
+    builder.define_default<TestObject_1>([]() -> TestObject_1*
+    {
+        return new TestObject_1 { sample_id };
+    },
+    [](TestObject_1* instance)
+    {
+        released++;
+        delete instance;
+    });
+
+    shared_ptr<TestObject_1> instance;
+    {
+        instance_activator activator(std::move(builder));
+        instance = activator.activate_default_shared<TestObject_1>();
+        activator.activate_default_shared<TestObject_1>();
+        ASSERT_EQ(released, 1);
+    }
+
+    instance.reset();
+    ASSERT_EQ(released, 2);
+}
@@ -0,0 +1,150 @@
+#include <di/lazy.hpp>
+#include <di/definition_builder.hpp>
+#include <di/instance_activator.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace testing;
+using namespace di;
+
+
+namespace {
+
+struct heavy_dependency
+{
+    string field1_;
+};
+
+struct component
+{
+    lazy<heavy_dependency> dependency_;
+};
+
+}
+
+TEST(lazy, activate_on_first_access)
+{
+    auto activations = 0;
+
+    definition_builder builder;
+    builder.define_default<heavy_dependency>([&activations]() -> heavy_dependency
+    {
+        activations++;
+        return { "heavy" };
+    });
+    builder.define_default<component>([](const activation_context& context) -> component
+    {
+        return { context.activate_default_lazy<heavy_dependency>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_unique<component>();
+
+    ASSERT_EQ(activations, 0);
+    ASSERT_FALSE(instance->dependency_.is_activated());
+
+    ASSERT_EQ(instance->dependency_->field1_, "heavy");
+    ASSERT_EQ((*instance->dependency_).field1_, "heavy");
+    ASSERT_EQ(activations, 1);
+    ASSERT_TRUE(instance->dependency_.is_activated());
+}
+
+TEST(lazy, activate_with_captured_arguments_and_annotations)
+{
+    definition_builder builder;
+    builder.define<heavy_dependency, const string&>("named", [](const activation_context& context, const string& suffix)
+            -> heavy_dependency
+    {
+        return { context.annotation<string>() + suffix };
+    });
+    builder.define_default<component>([](const activation_context& context) -> component
+    {
+        string suffix("-suffix");
+        return { context.activate_lazy<heavy_dependency, const string&>("named", suffix) };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_unique<component>(annotations_map(string("annotation")));
+
+    ASSERT_EQ(instance->dependency_->field1_, "annotation-suffix");
+}
+
+TEST(lazy, activate_once_concurrently)
+{
+    atomic<int> activations(0);
+
+    definition_builder builder;
+    builder.define_default<heavy_dependency>([&activations]() -> heavy_dependency
+    {
+        activations++;
+        this_thread::yield();
+        return { "heavy" };
+    });
+    builder.define_default<component>([](const activation_context& context) -> component
+    {
+        return { context.activate_default_lazy<heavy_dependency>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_unique<component>();
+
+    vector<thread> threads;
+    vector<heavy_dependency*> accessed(8u);
+    for (auto i = 0u; i < accessed.size(); i++)
+        threads.emplace_back([&, i]()
+        {
+            accessed[i] = instance->dependency_.get();
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(activations, 1);
+    ASSERT_THAT(accessed, Each(Eq(accessed.front())));
+}
+
+TEST(lazy, activate_missing_definition)
+{
+    definition_builder builder;
+    builder.define_default<component>([](const activation_context& context) -> component
+    {
+        return { context.activate_default_lazy<heavy_dependency>() };
+    });
+
+    instance_activator activator(std::move(builder));
+
+    ASSERT_THROW(activator.activate_default_unique<component>(), invalid_argument);
+}
+
+TEST(lazy, activate_reattempted_after_failure)
+{
+    auto attempts = 0;
+
+    definition_builder builder;
+    builder.define_default<heavy_dependency>([&attempts]() -> heavy_dependency
+    {
+        if (attempts++ == 0)
+            throw runtime_error("first attempt");
+
+        return { "heavy" };
+    });
+    builder.define_default<component>([](const activation_context& context) -> component
+    {
+        return { context.activate_default_lazy<heavy_dependency>() };
+    });
+
+    instance_activator activator(std::move(builder));
+    auto instance = activator.activate_default_unique<component>();
+
+    ASSERT_THROW(instance->dependency_.get(), runtime_error);
+    ASSERT_FALSE(instance->dependency_.is_activated());
+    ASSERT_EQ(instance->dependency_->field1_, "heavy");
+}
@@ -0,0 +1,308 @@
+#include <di/lifetime.hpp>
+#include <di/activation_context.hpp>
+#include <di/definition_builder.hpp>
+#include <di/instance_activator.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace testing;
+using namespace di;
+
+
+namespace {
+
+struct symbol
+{
+    string name_;
+    int version_;
+};
+
+class lifetime_test : public Test
+{
+protected:
+    lifetime_test()
+        :
+            activator_(definition_builder()),
+            context_("", activator_)
+    {
+
+    }
+
+    instance_activator activator_;
+    activation_context context_;
+};
+
+}
+
+TEST_F(lifetime_test, single_instance)
+{
+    single_instance_lifetime<symbol> lifetime;
+
+    auto created = 0;
+    auto create = [&created]()
+    {
+        created++;
+        return make_shared<symbol>(symbol { "a", 1 });
+    };
+
+    auto instance_1 = lifetime(context_, create);
+    auto instance_2 = lifetime(context_, create);
+    ASSERT_EQ(created, 1);
+    ASSERT_EQ(instance_1, instance_2);
+}
+
+TEST_F(lifetime_test, memoized_by_arguments)
+{
+    memoized_lifetime<symbol, const string&, int> lifetime(16u);
+
+    auto created = 0;
+    auto activate = [&](const string& name, int version)
+    {
+        return lifetime(context_, name, version, [&]()
+        {
+            created++;
+            return make_shared<symbol>(symbol { name, version });
+        });
+    };
+
+    auto instance_1 = activate("a", 1);
+    auto instance_2 = activate("a", 2);
+    auto instance_3 = activate("a", 1);
+    ASSERT_EQ(created, 2);
+    ASSERT_EQ(instance_1, instance_3);
+    ASSERT_NE(instance_1, instance_2);
+    ASSERT_EQ(instance_2->version_, 2);
+    ASSERT_EQ(lifetime.size(), 2u);
+}
+
+TEST_F(lifetime_test, memoized_evicts_least_recently_used)
+{
+    memoized_lifetime<symbol, string> lifetime(2u, 1u);
+
+    auto created = 0;
+    auto activate = [&](const string& name)
+    {
+        return lifetime(context_, name, [&]()
+        {
+            created++;
+            return make_shared<symbol>(symbol { name, 0 });
+        });
+    };
+
+    activate("a");
+    activate("b");
+    activate("a");
+    activate("c");
+    ASSERT_EQ(created, 3);
+    ASSERT_EQ(lifetime.size(), 2u);
+
+    activate("a");
+    ASSERT_EQ(created, 3);
+
+    activate("b");
+    ASSERT_EQ(created, 4);
+}
+
+TEST_F(lifetime_test, memoized_bounded_by_capacity)
+{
+    for (auto capacity : { 1u, 4u, 20u })
+    {
+        memoized_lifetime<symbol, int> lifetime(capacity);
+        for (auto key = 0; key < 1000; key++)
+            lifetime(context_, key, [key]() { return make_shared<symbol>(symbol { "", key }); });
+
+        ASSERT_EQ(lifetime.size(), capacity);
+    }
+}
+
+TEST_F(lifetime_test, memoized_evicted_instance_alive)
+{
+    memoized_lifetime<symbol, int> lifetime(1u, 1u);
+
+    auto evicted = lifetime(context_, 1, []() { return make_shared<symbol>(symbol { "a", 1 }); });
+    lifetime(context_, 2, []() { return make_shared<symbol>(symbol { "b", 2 }); });
+
+    ASSERT_EQ(evicted.use_count(), 1);
+    ASSERT_EQ(evicted->name_, "a");
+}
+
+TEST_F(lifetime_test, memoized_concurrently)
+{
+    memoized_lifetime<symbol, int> lifetime(1024u);
+
+    const auto threads_count = 4;
+    const auto keys_count = 64;
+
+    vector<vector<shared_ptr<symbol>>> activated(threads_count);
+    vector<thread> threads;
+    for (auto i = 0; i < threads_count; i++)
+    {
+        threads.emplace_back([&, i]()
+        {
+            for (auto key = 0; key < keys_count; key++)
+            {
+                activated[i].push_back(lifetime(context_, key, [key]()
+                {
+                    return make_shared<symbol>(symbol { "", key });
+                }));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(lifetime.size(), static_cast<size_t>(keys_count));
+    for (auto i = 1; i < threads_count; i++)
+        ASSERT_EQ(activated[i], activated[0]);
+}
+
+TEST_F(lifetime_test, weak_instance_shared_while_held)
+{
+    weak_instance_lifetime<symbol> lifetime;
+
+    auto created = 0;
+    auto create = [&created]()
+    {
+        created++;
+        return make_shared<symbol>(symbol { "a", created });
+    };
+
+    auto instance_1 = lifetime(context_, create);
+    auto instance_2 = lifetime(context_, create);
+    ASSERT_EQ(created, 1);
+    ASSERT_EQ(instance_1, instance_2);
+
+    instance_1.reset();
+    instance_2.reset();
+
+    auto instance_3 = lifetime(context_, create);
+    ASSERT_EQ(created, 2);
+    ASSERT_EQ(instance_3->version_, 2);
+}
+
+TEST_F(lifetime_test, weak_instance_by_arguments)
+{
+    weak_instance_lifetime<symbol, const string&> lifetime;
+
+    auto created = 0;
+    auto activate = [&](const string& name)
+    {
+        return lifetime(context_, name, [&]()
+        {
+            created++;
+            return make_shared<symbol>(symbol { name, 0 });
+        });
+    };
+
+    auto instance_1 = activate("a");
+    auto instance_2 = activate("b");
+    ASSERT_EQ(created, 2);
+    ASSERT_EQ(activate("a"), instance_1);
+    ASSERT_EQ(activate("b")->name_, "b");
+    ASSERT_EQ(created, 2);
+}
+
+TEST_F(lifetime_test, weak_instance_purges_destroyed)
+{
+    weak_instance_lifetime<symbol, int> lifetime;
+
+    auto held = lifetime(context_, -1, []() { return make_shared<symbol>(symbol { "held", -1 }); });
+    for (auto key = 0; key < 100; key++)
+        lifetime(context_, key, [key]() { return make_shared<symbol>(symbol { "", key }); });
+
+    ASSERT_LT(lifetime.size(), 100u);
+    ASSERT_EQ(lifetime(context_, -1, []() { return make_shared<symbol>(symbol { "", 0 }); }), held);
+}
+
+TEST_F(lifetime_test, per_cpu_instance_per_shard)
+{
+    per_cpu_lifetime<symbol> lifetime(1u);
+
+    auto created = 0;
+    auto create = [&created]()
+    {
+        created++;
+        return make_shared<symbol>(symbol { "a", created });
+    };
+
+    auto instance_1 = lifetime(context_, create);
+    auto instance_2 = lifetime(context_, create);
+    ASSERT_EQ(created, 1);
+    ASSERT_EQ(instance_1, instance_2);
+
+    auto shards = lifetime.shards();
+    ASSERT_EQ(shards.size(), 1u);
+    ASSERT_THAT(shards.instances(), ElementsAre(instance_1));
+}
+
+TEST_F(lifetime_test, per_cpu_instance_aligned)
+{
+    per_cpu_lifetime<symbol> lifetime(4u);
+
+    auto released = 0;
+    auto create = [&released]()
+    {
+        return shared_ptr<symbol>(new symbol { "a", 1 }, [&released](symbol* instance)
+        {
+            released++;
+            delete instance;
+        });
+    };
+
+    auto instance = lifetime(context_, create);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(instance.get()) % 64u, 0u);
+    ASSERT_EQ(instance->name_, "a");
+    ASSERT_EQ(instance->version_, 1);
+
+    for (auto& shard : lifetime.shards().instances())
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(shard.get()) % 64u, 0u);
+
+    ASSERT_EQ(released, 0);
+    lifetime = per_cpu_lifetime<symbol>(4u);
+    ASSERT_EQ(released, 0);
+    instance.reset();
+    ASSERT_EQ(released, 1);
+}
+
+TEST_F(lifetime_test, per_cpu_concurrently)
+{
+    per_cpu_lifetime<atomic<int>> lifetime;
+
+    const auto threads_count = 4;
+    const auto increments_count = 1000;
+
+    vector<thread> threads;
+    for (auto i = 0; i < threads_count; i++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (auto j = 0; j < increments_count; j++)
+            {
+                auto counter = lifetime(context_, []() { return make_shared<atomic<int>>(0); });
+                (*counter)++;
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto total = 0;
+    auto instances = lifetime.shards().instances();
+    for (auto& instance : instances)
+        total += *instance;
+
+    ASSERT_GE(instances.size(), 1u);
+    ASSERT_LE(instances.size(), lifetime.shards().size());
+    ASSERT_EQ(total, threads_count * increments_count);
+}
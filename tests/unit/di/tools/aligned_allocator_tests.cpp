@@ -0,0 +1,45 @@
+#include <di/tools/aligned_allocator.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace di::tools;
+
+
+TEST(aligned_allocator, allocate)
+{
+    aligned_allocator<char, 64u> allocator;
+
+    for (auto size = 1u; size < 130u; size++)
+    {
+        auto elements = allocator.allocate(size);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(elements) % 64u, 0u);
+
+        for (auto i = 0u; i < size; i++)
+            elements[i] = static_cast<char>(i);
+
+        allocator.deallocate(elements, size);
+    }
+}
+
+TEST(aligned_allocator, allocate_shared)
+{
+    vector<shared_ptr<int>> instances;
+    for (auto i = 0; i < 16; i++)
+        instances.push_back(allocate_shared<int>(aligned_allocator<int, 64u>(), i));
+
+    for (auto i = 0; i < 16; i++)
+    {
+        ASSERT_EQ(*instances[i], i);
+
+        // the control block and the instance occupy whole cache lines
+        auto line = reinterpret_cast<uintptr_t>(instances[i].get()) / 64u;
+        for (auto j = 0; j < i; j++)
+            ASSERT_NE(reinterpret_cast<uintptr_t>(instances[j].get()) / 64u, line);
+    }
+}
@@ -0,0 +1,86 @@
+#include <di/tools/aligned_array.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+using namespace di::tools;
+
+
+namespace {
+
+struct padded
+{
+    padded()
+    {
+        live_count++;
+    }
+
+    ~padded()
+    {
+        live_count--;
+    }
+
+    shared_ptr<int> instance;
+    char padding[64u - sizeof(shared_ptr<int>)];
+
+    static int live_count;
+};
+
+int padded::live_count = 0;
+
+struct failing
+{
+    failing()
+    {
+        if (++created_count == 3)
+            throw runtime_error("failed");
+
+        live_count++;
+    }
+
+    ~failing()
+    {
+        live_count--;
+    }
+
+    char padding[32u];
+
+    static int created_count;
+    static int live_count;
+};
+
+int failing::created_count = 0;
+int failing::live_count = 0;
+
+}
+
+TEST(aligned_array, create)
+{
+    for (auto size = 0u; size < 8u; size++)
+    {
+        aligned_array<padded, 64u> array(size);
+        ASSERT_EQ(array.size(), size);
+        ASSERT_EQ(padded::live_count, static_cast<int>(size));
+
+        for (auto i = 0u; i < size; i++)
+        {
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(&array[i]) % 64u, 0u);
+            ASSERT_FALSE(array[i].instance);
+        }
+    }
+
+    ASSERT_EQ(padded::live_count, 0);
+}
+
+TEST(aligned_array, create_failure)
+{
+    using array_type = aligned_array<failing, 32u>;
+
+    ASSERT_THROW(array_type(4u), runtime_error);
+    ASSERT_EQ(failing::live_count, 0);
+}
@@ -0,0 +1,58 @@
+#include <di/tools/function_ref.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+using namespace std;
+using namespace di::tools;
+
+
+namespace {
+
+int invoke(function_ref<int(int)> function, int argument)
+{
+    return function(argument);
+}
+
+}
+
+TEST(function_ref, invoke_lambda)
+{
+    auto offset = 2;
+    auto function = [offset](int value)
+    {
+        return value + offset;
+    };
+
+    ASSERT_EQ(invoke(function, 1), 3);
+}
+
+TEST(function_ref, invoke_mutable_lambda)
+{
+    auto calls = 0;
+    auto function = [&calls](int value) mutable
+    {
+        return value + ++calls;
+    };
+
+    ASSERT_EQ(invoke(function, 1), 2);
+    ASSERT_EQ(invoke(function, 1), 3);
+}
+
+TEST(function_ref, copy)
+{
+    auto function = [](string& value)
+    {
+        value += "-referenced";
+    };
+
+    function_ref<void(string&)> reference = function;
+    auto copy = reference;
+
+    string value("value");
+    copy(value);
+
+    ASSERT_EQ(value, "value-referenced");
+}
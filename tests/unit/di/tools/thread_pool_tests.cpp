@@ -0,0 +1,125 @@
+#include <di/tools/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace di::tools;
+
+
+TEST(thread_pool, create)
+{
+    thread_pool pool(2u);
+    ASSERT_EQ(pool.concurrency(), 2u);
+}
+
+TEST(thread_pool, submit)
+{
+    thread_pool pool(2u);
+
+    vector<future<int>> results;
+    for (auto i = 0; i < 10; i++)
+        results.push_back(pool.submit([i]()
+        {
+            return i * i;
+        }));
+
+    for (auto i = 0; i < 10; i++)
+        ASSERT_EQ(pool.wait(results[i]), i * i);
+}
+
+TEST(thread_pool, submit_failure)
+{
+    thread_pool pool(1u);
+
+    auto result = pool.submit([]() -> int
+    {
+        throw runtime_error("failure");
+    });
+
+    ASSERT_THROW(pool.wait(result), runtime_error);
+}
+
+TEST(thread_pool, wait_nested_on_single_worker)
+{
+    thread_pool pool(1u);
+
+    auto outer = pool.submit([&pool]()
+    {
+        auto inner = pool.submit([]()
+        {
+            return 1;
+        });
+
+        return pool.wait(inner) + 1;
+    });
+
+    ASSERT_EQ(pool.wait(outer), 2);
+}
+
+TEST(thread_pool, run_pending_empty)
+{
+    thread_pool pool(1u);
+    ASSERT_FALSE(pool.run_pending());
+}
+
+TEST(thread_pool, wait_deferred)
+{
+    thread_pool pool(1u);
+
+    auto deferred = async(launch::deferred, []()
+    {
+        return 1;
+    });
+
+    ASSERT_EQ(pool.wait(deferred), 1);
+}
+
+TEST(thread_pool, wait_within_scope)
+{
+    thread_pool pool(1u);
+
+    promise<void> release;
+    auto released = release.get_future().share();
+    atomic<bool> blocked(false);
+    auto blocker = pool.submit([released, &blocked]()
+    {
+        blocked = true;
+        released.wait();
+    });
+
+    while (!blocked)
+        this_thread::yield();
+
+    atomic<bool> unrelated_executed(false);
+    auto unrelated = pool.submit([&unrelated_executed]()
+    {
+        unrelated_executed = true;
+    });
+
+    int result;
+    {
+        thread_pool::scope scope;
+        auto owned = pool.submit([]()
+        {
+            return 1;
+        });
+
+        result = pool.wait(owned);
+    }
+    auto executed_within_scope = unrelated_executed.load();
+
+    release.set_value();
+    pool.wait(blocker);
+    pool.wait(unrelated);
+
+    ASSERT_EQ(result, 1);
+    ASSERT_FALSE(executed_within_scope);
+    ASSERT_TRUE(unrelated_executed);
+}
@@ -0,0 +1,140 @@
+#include <di/trace_recorder.hpp>
+#include <di/activation_context.hpp>
+#include <di/definition_builder.hpp>
+#include <di/instance_activator.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace testing;
+using namespace di;
+
+
+namespace {
+
+struct traced_dependency
+{
+    int value_;
+};
+
+struct traced_component
+{
+    traced_dependency dependency_;
+};
+
+definition_builder traced_definitions()
+{
+    definition_builder builder;
+    builder.define<traced_dependency>("dependency", []() -> traced_dependency
+    {
+        return { 42 };
+    });
+    builder.define_default<traced_component>([](const activation_context& context) -> traced_component
+    {
+        return { context.activate_raii<traced_dependency>("dependency") };
+    });
+
+    return builder;
+}
+
+size_t count_spans(const string& trace)
+{
+    size_t count = 0u;
+    for (auto position = trace.find("\"ph\":\"X\""); position != string::npos; position = trace.find("\"ph\":\"X\"", position + 1u))
+        count++;
+
+    return count;
+}
+
+}
+
+TEST(trace_recorder, write_empty)
+{
+    trace_recorder recorder;
+
+    stringstream trace;
+    recorder.write(trace);
+    ASSERT_THAT(trace.str(), StartsWith("{\"traceEvents\":[],"));
+}
+
+TEST(trace_recorder, record_nested_activations)
+{
+    auto recorder = make_shared<trace_recorder>();
+
+    instance_activator activator(traced_definitions());
+    activator.set_tracer(recorder);
+    activator.activate_default_unique<traced_component>();
+
+    stringstream trace;
+    recorder->write(trace);
+    ASSERT_EQ(count_spans(trace.str()), 2u);
+    ASSERT_THAT(trace.str(), HasSubstr("\"name\":\"(anonymous namespace)::traced_component\""));
+    ASSERT_THAT(trace.str(), HasSubstr("\"args\":{\"id\":\"dependency\",\"depth\":1,\"failed\":false}"));
+    ASSERT_THAT(trace.str(), HasSubstr("\"args\":{\"id\":\"\",\"depth\":0,\"failed\":false}"));
+}
+
+TEST(trace_recorder, record_failure)
+{
+    definition_builder builder;
+    builder.define_default<traced_dependency>([]() -> traced_dependency
+    {
+        throw runtime_error("failed");
+    });
+
+    auto recorder = make_shared<trace_recorder>();
+
+    instance_activator activator(std::move(builder));
+    activator.set_tracer(recorder);
+    ASSERT_THROW(activator.activate_default_unique<traced_dependency>(), runtime_error);
+
+    stringstream trace;
+    recorder->write(trace);
+    ASSERT_THAT(trace.str(), HasSubstr("\"failed\":true"));
+}
+
+TEST(trace_recorder, record_overwrites_oldest)
+{
+    auto recorder = make_shared<trace_recorder>(3u);
+
+    instance_activator activator(traced_definitions());
+    activator.set_tracer(recorder);
+    for (auto i = 0; i < 5; i++)
+        activator.activate_default_unique<traced_component>();
+
+    stringstream trace;
+    recorder->write(trace);
+    ASSERT_EQ(count_spans(trace.str()), 3u);
+}
+
+TEST(trace_recorder, record_per_thread)
+{
+    auto recorder = make_shared<trace_recorder>();
+
+    instance_activator activator(traced_definitions());
+    activator.set_tracer(recorder);
+
+    vector<thread> threads;
+    for (auto i = 0; i < 4; i++)
+        threads.emplace_back([&activator]()
+        {
+            for (auto j = 0; j < 10; j++)
+                activator.activate_default_unique<traced_component>();
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    stringstream trace;
+    recorder->write(trace);
+    ASSERT_EQ(count_spans(trace.str()), 80u);
+    for (auto tid = 0; tid < 4; tid++)
+        ASSERT_THAT(trace.str(), HasSubstr("\"tid\":" + to_string(tid) + ","));
+}
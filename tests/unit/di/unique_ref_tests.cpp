@@ -0,0 +1,69 @@
+#include <di/unique_ref.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <memory>
+
+using namespace std;
+using namespace di;
+
+
+TEST(unique_ref, size)
+{
+    static_assert(sizeof(deleter<int>) == sizeof(void*), "deleter should be a single pointer!");
+    static_assert(sizeof(unique_ref<int>) == 2u * sizeof(void*), "unique_ref should be two pointers!");
+}
+
+TEST(unique_ref, default_deleter)
+{
+    static auto destroyed = 0;
+
+    struct counted
+    {
+        ~counted()
+        {
+            destroyed++;
+        }
+    };
+
+    {
+        unique_ref<counted> instance(new counted());
+    }
+    ASSERT_EQ(destroyed, 1);
+}
+
+TEST(unique_ref, empty_function_deleter)
+{
+    static auto destroyed = 0;
+
+    struct counted
+    {
+        ~counted()
+        {
+            destroyed++;
+        }
+    };
+
+    function<void(counted*)> function;
+    {
+        unique_ref<counted> instance(new counted(), deleter<counted>(function));
+    }
+    ASSERT_EQ(destroyed, 1);
+}
+
+TEST(unique_ref, function_deleter)
+{
+    int value = 0;
+    int* released = nullptr;
+
+    function<void(int*)> function = [&released](int* instance)
+    {
+        released = instance;
+    };
+    {
+        unique_ref<int> instance(&value, deleter<int>(function));
+    }
+    ASSERT_EQ(released, &value);
+}